@@ -0,0 +1,82 @@
+#ifndef ALERTCATALOG_H
+#define ALERTCATALOG_H
+
+#include "EngineState.h"
+#include <cstddef>
+
+// 告警目录
+// 每条告警在此声明一次：编号、级别、文本和去重时间窗。
+// 检测时只用编号，去重按编号查数组，只有告警真正触发时才格式化文本
+enum class AlertId {
+    N1OverSpeed2,           // N1 超转 2 级
+    N1OverSpeed1,           // N1 超转 1 级
+    EGTOverTempStart2,      // 启动阶段 EGT 超温 2 级
+    EGTOverTempStart1,      // 启动阶段 EGT 超温 1 级
+    EGTOverTempStable4,     // 稳态 EGT 超温 4 级
+    EGTOverTempStable3,     // 稳态 EGT 超温 3 级
+    LowFuel,                // 低油量
+    FuelFlowOverSpeed,      // 燃油流速超限
+    FuelSensorFail,         // 燃油传感器故障
+    N1AllSensorsFail,       // N1 全部传感器故障
+    N1LeftSensorsFail,      // 左发 N1 双传感器故障
+    N1LeftSensorFail,       // 左发 N1 单传感器故障
+    N1RightSensorsFail,     // 右发 N1 双传感器故障
+    N1RightSensorFail,      // 右发 N1 单传感器故障
+    EGTAllSensorsFail,      // EGT 全部传感器故障
+    EGTLeftSensorsFail,     // 左发 EGT 双传感器故障
+    EGTLeftSensorFail,      // 左发 EGT 单传感器故障
+    EGTRightSensorsFail,    // 右发 EGT 双传感器故障
+    EGTRightSensorFail,     // 右发 EGT 单传感器故障
+    Count
+};
+
+constexpr size_t ALERT_COUNT = static_cast<size_t>(AlertId::Count);
+
+// 同一告警的默认去重时间窗（秒）
+constexpr double ALERT_DEDUP_WINDOW = 5.0;
+
+struct AlertInfo {
+    AlertId id;
+    AlertLevel level;
+    const char* message;
+    double dedupWindow;   // 时间窗内同一告警只记录一次
+};
+
+constexpr AlertInfo ALERT_CATALOG[] = {
+    { AlertId::N1OverSpeed2, AlertLevel::redWarning, "[Red Warning] N1 overspeed level 2: Exceeds 120% N1", ALERT_DEDUP_WINDOW },
+    { AlertId::N1OverSpeed1, AlertLevel::amberWarning, "[Amber Warning] N1 overspeed level 1: Exceeds 105% N1", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTOverTempStart2, AlertLevel::redWarning, "[Red Warning] EGT overtemp level 2: Exceeds 100\xE2\x84\x83 during engine start", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTOverTempStart1, AlertLevel::amberWarning, "[Amber Warning] EGT overtemp level 1: Exceeds 850 \xE2\x84\x83 during engine start", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTOverTempStable4, AlertLevel::redWarning, "[Red Warning] EGT overtemp level 4: Exceeds 1100 \xE2\x84\x83 in stable operation", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTOverTempStable3, AlertLevel::amberWarning, "[Amber Warning] EGT overtemp level 3: Exceeds 950 \xE2\x84\x83 in stable operation", ALERT_DEDUP_WINDOW },
+    { AlertId::LowFuel, AlertLevel::amberWarning, "[Amber Warning] Fuel level: Below 1000 lbs", ALERT_DEDUP_WINDOW },
+    { AlertId::FuelFlowOverSpeed, AlertLevel::amberWarning, "[Amber Warning] Fuel flow: Exceeds 50 lbs per second", ALERT_DEDUP_WINDOW },
+    { AlertId::FuelSensorFail, AlertLevel::redWarning, "[Red Warning] Fuel system: Sensor failure", ALERT_DEDUP_WINDOW },
+    { AlertId::N1AllSensorsFail, AlertLevel::redWarning, "[Red Warning] N1 system: Critical failure all sensors failed", ALERT_DEDUP_WINDOW },
+    { AlertId::N1LeftSensorsFail, AlertLevel::amberWarning, "[Amber Warning] N1 system: Left engine sensors failed", ALERT_DEDUP_WINDOW },
+    { AlertId::N1LeftSensorFail, AlertLevel::whiteWarning, "[White Warning] N1 system: Left engine single sensor failure", ALERT_DEDUP_WINDOW },
+    { AlertId::N1RightSensorsFail, AlertLevel::amberWarning, "[Amber Warning] N1 system: Right engine sensors failed", ALERT_DEDUP_WINDOW },
+    { AlertId::N1RightSensorFail, AlertLevel::whiteWarning, "[White Warning] N1 system: Right engine single sensor failure", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTAllSensorsFail, AlertLevel::redWarning, "[Red Warning] EGT system: Critical failure all sensors failed", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTLeftSensorsFail, AlertLevel::amberWarning, "[Amber Warning] EGT system: Left engine sensors failed", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTLeftSensorFail, AlertLevel::whiteWarning, "[White Warning] EGT system: Left engine single sensor failure", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTRightSensorsFail, AlertLevel::amberWarning, "[Amber Warning] EGT system: Right engine sensors failed", ALERT_DEDUP_WINDOW },
+    { AlertId::EGTRightSensorFail, AlertLevel::whiteWarning, "[White Warning] EGT system: Right engine single sensor failure", ALERT_DEDUP_WINDOW },
+};
+
+// 目录按编号顺序排列，编号可直接作为下标
+constexpr bool alertCatalogOrdered() {
+    for (size_t i = 0; i < ALERT_COUNT; ++i) {
+        if (static_cast<size_t>(ALERT_CATALOG[i].id) != i) return false;
+    }
+    return true;
+}
+static_assert(sizeof(ALERT_CATALOG) / sizeof(ALERT_CATALOG[0]) == ALERT_COUNT, "every AlertId needs a catalog entry");
+static_assert(alertCatalogOrdered(), "ALERT_CATALOG must be ordered by AlertId");
+
+// 按编号取目录项
+constexpr const AlertInfo& alertInfo(AlertId id) {
+    return ALERT_CATALOG[static_cast<size_t>(id)];
+}
+
+#endif // ALERTCATALOG_H
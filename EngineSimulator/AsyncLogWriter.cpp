@@ -0,0 +1,83 @@
+#include "AsyncLogWriter.h"
+#include "SpanTrace.h"
+#include <chrono>
+
+// 构造与析构
+AsyncLogWriter::AsyncLogWriter(Logger& logger, SampleRing<Sample>& ring)
+    : logger(logger), ring(ring), stopRequested(false),
+      commitIntervalMs(DEFAULT_COMMIT_INTERVAL_MS), commits(0) {
+}
+AsyncLogWriter::~AsyncLogWriter() {
+    stop();
+}
+
+// 设置组提交间隔
+void AsyncLogWriter::setCommitInterval(int milliseconds) {
+    commitIntervalMs.store(milliseconds < 0 ? 0 : milliseconds, std::memory_order_relaxed);
+}
+
+// 启动写入线程
+void AsyncLogWriter::start() {
+    if (worker.joinable()) return;
+    stopRequested.store(false, std::memory_order_relaxed);
+    worker = std::thread(&AsyncLogWriter::run, this);
+}
+
+// 停止写入线程
+void AsyncLogWriter::stop() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopRequested.store(true, std::memory_order_relaxed);
+    }
+    wakeCondition.notify_all();
+    worker.join();
+}
+
+bool AsyncLogWriter::isRunning() const {
+    return worker.joinable();
+}
+
+uint64_t AsyncLogWriter::commitCount() const {
+    return commits.load(std::memory_order_relaxed);
+}
+
+// 取出当前全部样本交给 Logger
+size_t AsyncLogWriter::drainOnce() {
+    return ring.drain([this](const Sample& sample) {
+        logger.consume(sample);
+    });
+}
+
+// 线程主循环
+void AsyncLogWriter::run() {
+    trace::setThreadName("log");
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastCommit = Clock::now();
+    bool pending = false;
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        if (drainOnce() > 0) {
+            pending = true;
+        }
+
+        // 组提交：距上次提交超过间隔时统一 flush
+        Clock::time_point now = Clock::now();
+        int interval = commitIntervalMs.load(std::memory_order_relaxed);
+        if (pending && now - lastCommit >= std::chrono::milliseconds(interval)) {
+            logger.flush();
+            commits.fetch_add(1, std::memory_order_relaxed);
+            lastCommit = now;
+            pending = false;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL_MS),
+            [this] { return stopRequested.load(std::memory_order_relaxed); });
+    }
+
+    // 退出前写完剩余样本
+    drainOnce();
+    logger.flush();
+    commits.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,60 @@
+#ifndef ASYNCLOGWRITER_H
+#define ASYNCLOGWRITER_H
+
+#include "Logger.h"
+#include "SampleRing.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// 后台日志写入线程
+// 从样本缓冲区批量取出样本交给 Logger，磁盘写入全部在本线程完成，模拟线程只负责入队；
+// 文件流使用大缓冲区，按组提交间隔统一 flush，磁盘变慢时只会让缓冲区积压，不影响模拟步长。
+// 启动后 Logger 只能由本线程访问（告警回调也在本线程中调用）
+class AsyncLogWriter {
+public:
+    // 默认组提交间隔（毫秒）
+    static constexpr int DEFAULT_COMMIT_INTERVAL_MS = 500;
+
+    AsyncLogWriter(Logger& logger, SampleRing<Sample>& ring);
+    ~AsyncLogWriter();
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    // 设置组提交间隔，0 表示每批写入后立即 flush
+    void setCommitInterval(int milliseconds);
+
+    // 启动写入线程
+    void start();
+
+    // 停止写入线程：写完缓冲区中剩余的样本并 flush
+    void stop();
+
+    bool isRunning() const;
+
+    // 已执行的组提交次数
+    uint64_t commitCount() const;
+
+private:
+    // 线程主循环
+    void run();
+
+    // 取出当前全部样本交给 Logger，返回样本数
+    size_t drainOnce();
+
+    // 无新样本时的轮询间隔（毫秒）
+    static constexpr int POLL_INTERVAL_MS = 10;
+
+    Logger& logger;
+    SampleRing<Sample>& ring;
+
+    std::thread worker;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> stopRequested;
+    std::atomic<int> commitIntervalMs;
+    std::atomic<uint64_t> commits;
+};
+
+#endif // ASYNCLOGWRITER_H
@@ -0,0 +1,688 @@
+#include "Simulation.h"
+#include "Logger.h"
+#include "AsyncLogWriter.h"
+#include "TelemetryLog.h"
+#include "LogPlayback.h"
+#include "TelemetryPyramid.h"
+#include "CsvWriter.h"
+#include "FleetGenerator.h"
+#include "SimdKernels.h"
+#include "Log10Table.h"
+#include "SweepRunner.h"
+#include "InputJournal.h"
+#include "Checkpoint.h"
+#include "SpanTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 命令行批处理程序：不依赖界面，以 CPU 允许的最快速度推进模拟并写出 DataLogging 日志
+
+// 脚本中的一条定时指令
+struct ScriptEntry {
+    double time;      // 触发时间（秒，从批处理开始计）
+    Command command;  // 指令
+};
+
+// 打印用法
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+        << "  --duration <s>    simulated seconds to run (default 600)\n"
+        << "  --out <dir>       log directory (default ./DataLogging)\n"
+        << "  --script <file>   command script, one \"<time_s> <Command>\" per line\n"
+        << "  --format <f>      data log format: text, binary or both (default text)\n"
+        << "  --commit-interval <ms>\n"
+        << "                    write logs on a background thread, flushing every <ms>\n"
+        << "  --seed <n>        random seed (default: random, printed at exit)\n"
+        << "  --seek <s>        start the engine (or --restore), jump straight to <s> seconds\n"
+        << "                    and print the state there\n"
+        << "  --stats <file>    record per-stage step timing histograms, print them and write <file>\n"
+        << "  --trace <file.json>\n"
+        << "                    record spans of every step stage and log write as Chrome trace JSON\n"
+        << "  --no-log          do not write log files\n"
+        << "  --quiet           do not print alerts\n"
+        << "  --fleet <n>       load test: step n independent engines for --duration, no logs\n"
+        << "  --kernels <k>     fleet kernels: auto, scalar, avx2, avx512 or table (default auto)\n"
+        << "  --check-kernels   validate the vector and table kernels against the scalar path and exit\n"
+        << "  --dump <file.tlm> print a binary telemetry log as CSV and exit\n"
+        << "  --playback <file.tlm> <s>\n"
+        << "                    open a recorded session through its time index, print the\n"
+        << "                    sample and alerts at <s> and the open / seek times, and exit\n"
+        << "  --build-pyramid <file.tlm>\n"
+        << "                    write the min/max/mean trend pyramid (.tlp) next to the log and exit\n"
+        << "  --trend <file.tlm> <channel> <from> <to> <pixels>\n"
+        << "                    print about 2 x <pixels> min/max/mean points of <channel>\n"
+        << "                    (n1-left, n1-right, egt-left, egt-right, fuel-level, fuel-flow)\n"
+        << "                    over [from, to] s as CSV, building the pyramid if needed\n"
+        << "  --sweep <file>    Monte Carlo sweep: run a scenario template once per seed\n"
+        << "  --seeds <a:b>     sweep seed range, inclusive (default 1:100)\n"
+        << "  --threads <n>     sweep worker threads (default: all hardware threads)\n"
+        << "  --summary <file>  sweep summary CSV (default sweep_summary.csv)\n"
+        << "  --record <file>   record the seed and every command to an input journal (.jnl)\n"
+        << "  --replay <file>   replay an input journal bit-exactly instead of a script\n"
+        << "  --save-checkpoint <file.ckp>\n"
+        << "                    save the full simulator state when the engine first reaches\n"
+        << "                    Stable, or at --checkpoint-at <s>\n"
+        << "  --restore <file.ckp>\n"
+        << "                    start from a checkpoint; script times count from the restore.\n"
+        << "                    With --sweep every seed forks from the checkpoint\n"
+        << "Without --script the engine is started at t=0 and left running.\n";
+}
+
+// 读取指令脚本，# 开头为注释
+static bool loadScript(const std::string& path, std::vector<ScriptEntry>& entries) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open script: " << path << "\n";
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        ScriptEntry entry;
+        std::string name;
+        if (!(fields >> entry.time)) continue;
+        if (!(fields >> name) || !commandFromName(name, entry.command)) {
+            std::cerr << path << ":" << lineNumber << ": unknown command \"" << name << "\"\n";
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const ScriptEntry& a, const ScriptEntry& b) { return a.time < b.time; });
+    return true;
+}
+
+// 将二进制列式日志按 CSV 输出到标准输出
+static int dumpTelemetry(const std::string& path) {
+    TelemetryReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Cannot open telemetry log: " << path << "\n";
+        return 1;
+    }
+    CsvWriter csv;
+    csv.attach(stdout);
+    double values[CsvWriter::VALUE_COLUMNS];
+    for (size_t b = 0; b < reader.blockCount(); ++b) {
+        const TelemetryBlock& block = reader.block(b);
+        for (uint32_t i = 0; i < block.rows; ++i) {
+            for (int c = 0; c < CsvWriter::VALUE_COLUMNS; ++c) {
+                values[c] = block.values[c][i];
+            }
+            csv.appendRow(block.time[i], values, static_cast<EnginePhase>(block.phase[i]), block.valid[i]);
+        }
+    }
+    csv.close();
+    return 0;
+}
+
+// 回放定位：打开已记录的会话，输出指定时刻的样本和此前的告警，并测量随机定位的耗时
+static int playbackAt(const std::string& path, double time) {
+    LogPlayback playback;
+    auto openStart = std::chrono::steady_clock::now();
+    if (!playback.open(path)) {
+        std::cerr << "Cannot open telemetry log: " << path << "\n";
+        return 1;
+    }
+    const double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - openStart).count();
+
+    Sample sample;
+    playback.sampleAt(time, sample);
+    const SensorData& d = sample.data;
+    std::printf("t=%.3f row=%llu phase=%d N1L=%.2f N1R=%.2f EGTL=%.1f EGTR=%.1f fuel=%.1f flow=%.2f\n",
+        sample.time, static_cast<unsigned long long>(sample.tick), static_cast<int>(d.phase),
+        d.n1LeftAverage, d.n1RightAverage, d.egtLeftAverage, d.egtRightAverage, d.fuelLevel, d.fuelFlow);
+    const size_t alertCount = playback.alertsUntil(time);
+    for (size_t i = alertCount > 5 ? alertCount - 5 : 0; i < alertCount; ++i) {
+        std::printf("  %s\n", playback.alerts()[i].text.c_str());
+    }
+
+    // 随机定位：每次取一个新时刻的样本（含读取该行所在的映射页）
+    constexpr int SEEKS = 10000;
+    Xoshiro256PlusPlus rng(randomSeed());
+    const double span = playback.endTime() - playback.startTime();
+    double worstUs = 0.0;
+    auto seekStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < SEEKS; ++i) {
+        const double at = playback.startTime() + span * static_cast<double>(rng() >> 11) * 0x1.0p-53;
+        auto one = std::chrono::steady_clock::now();
+        playback.sampleAt(at, sample);
+        worstUs = std::max(worstUs, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - one).count());
+    }
+    const double meanUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - seekStart).count() / SEEKS;
+    std::printf("%llu rows, %.3f - %.3f s, %zu alerts; open %.3f ms (index %s); seek mean %.3f us, max %.1f us\n",
+        static_cast<unsigned long long>(playback.rowCount()), playback.startTime(), playback.endTime(),
+        playback.alerts().size(), openMs, playback.indexLoaded() ? "loaded" : "built", meanUs, worstUs);
+    return 0;
+}
+
+// 趋势金字塔的通道名（与 TelemetryChannel 顺序一致）
+static const char* const TREND_CHANNELS[] = { "n1-left", "n1-right", "egt-left", "egt-right", "fuel-level", "fuel-flow" };
+static_assert(sizeof(TREND_CHANNELS) / sizeof(TREND_CHANNELS[0]) == static_cast<size_t>(TelemetryChannel::Count),
+    "every telemetry channel needs a name");
+
+// 为二进制日志建立趋势金字塔
+static int buildPyramid(const std::string& path) {
+    TelemetryReader reader;
+    if (!reader.open(path, true)) {
+        std::cerr << "Cannot open telemetry log: " << path << "\n";
+        return 1;
+    }
+    const std::string pyramidPath = telemetryPyramidPath(path);
+    auto start = std::chrono::steady_clock::now();
+    if (!buildTelemetryPyramid(reader, pyramidPath)) return 1;
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    TelemetryPyramid pyramid;
+    if (!pyramid.open(pyramidPath)) return 1;
+    std::printf("%s: %llu rows, %zu levels (%u - %u rows per bucket), built in %.1f ms\n", pyramidPath.c_str(),
+        static_cast<unsigned long long>(pyramid.sourceRows()), pyramid.levelCount(),
+        1u << pyramid.levelShift(0), 1u << pyramid.levelShift(pyramid.levelCount() - 1), ms);
+    return 0;
+}
+
+// 输出一个通道在时间范围内的趋势点（CSV），金字塔缺失或与日志不一致时先重建
+static int printTrend(const std::string& path, const std::string& channelName, double from, double to, size_t pixels) {
+    const auto name = std::find(std::begin(TREND_CHANNELS), std::end(TREND_CHANNELS), channelName);
+    if (name == std::end(TREND_CHANNELS)) {
+        std::cerr << "Unknown channel: " << channelName << "\n";
+        return 1;
+    }
+    const TelemetryChannel channel = static_cast<TelemetryChannel>(name - std::begin(TREND_CHANNELS));
+    TelemetryReader reader;
+    if (!reader.open(path, true)) {
+        std::cerr << "Cannot open telemetry log: " << path << "\n";
+        return 1;
+    }
+    const std::string pyramidPath = telemetryPyramidPath(path);
+    TelemetryPyramid pyramid;
+    if (!pyramid.open(pyramidPath) || pyramid.sourceRows() != reader.rowCount()) {
+        pyramid.close();
+        if (!buildTelemetryPyramid(reader, pyramidPath) || !pyramid.open(pyramidPath)) return 1;
+    }
+
+    std::vector<TrendPoint> points;
+    auto start = std::chrono::steady_clock::now();
+    const uint32_t shift = pyramid.query(channel, from, to, pixels, points, &reader);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    // 无有效行的桶与 CSV 一样输出 N/A
+    std::printf("Timestamp(s),Min,Max,Mean\n");
+    for (const TrendPoint& point : points) {
+        if (std::isnan(point.mean)) std::printf("%.3f,N/A,N/A,N/A\n", point.time);
+        else std::printf("%.3f,%g,%g,%g\n", point.time, point.min, point.max, point.mean);
+    }
+    std::fprintf(stderr, "%zu points at %u rows per point, query %.1f us\n", points.size(), 1u << shift, us);
+    return 0;
+}
+
+// 机队负载测试：全部发动机在 0 时刻启动，按固定步长推进并统计吞吐
+static int runFleet(size_t engineCount, double duration, bool hasSeed, uint64_t seed, KernelPath kernels) {
+    if (!kernelPathAvailable(kernels)) {
+        std::cerr << "Kernels not supported on this CPU: " << kernelPathName(kernels) << "\n";
+        return 1;
+    }
+    FleetGenerator fleet(engineCount, 1, hasSeed ? seed : randomSeed());
+    fleet.setKernelPath(kernels);
+    fleet.startAll();
+
+    const uint64_t totalTicks = static_cast<uint64_t>(duration / TIME_STEP + 0.5);
+    auto wallStart = std::chrono::steady_clock::now();
+    for (uint64_t tick = 0; tick < totalTicks; ++tick) {
+        fleet.step();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    size_t stable = 0;
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        if (fleet.phase()[i] == static_cast<uint8_t>(EnginePhase::Stable)) ++stable;
+    }
+    double engineSteps = static_cast<double>(totalTicks) * engineCount;
+    std::printf("Fleet of %zu engines (%s kernels): %.3f s simulated (%llu ticks) in %.3f s wall\n",
+        engineCount, kernelPathName(kernels == KernelPath::Auto ? bestKernelPath() : kernels), totalTicks * TIME_STEP, static_cast<unsigned long long>(totalTicks), wallSeconds);
+    std::printf("%.1f M engine-steps/s, %.0f engines at %.0f Hz in real time, %zu stable\n",
+        wallSeconds > 0.0 ? engineSteps / wallSeconds * 1e-6 : 0.0,
+        wallSeconds > 0.0 ? engineSteps / wallSeconds * TIME_STEP : 0.0, 1.0 / TIME_STEP, stable);
+    std::printf("Seed: %llu\n", static_cast<unsigned long long>(fleet.seedValue()));
+    return 0;
+}
+
+// 校验各向量内核和查表内核
+static int checkKernels() {
+    bool ok = true;
+    const KernelPath paths[] = { KernelPath::Avx2, KernelPath::Avx512 };
+    for (KernelPath path : paths) {
+        if (!kernelPathAvailable(path)) {
+            std::printf("%-7s not supported on this CPU\n", kernelPathName(path));
+            continue;
+        }
+        KernelCheck check = checkKernel(path);
+        std::printf("%-7s log10 max error %.0f ulp (bound %.0f), noise %s, %zu samples: %s\n",
+            kernelPathName(path), check.maxLog10Ulp, LOG10_ULP_BOUND,
+            check.noiseExact ? "bit-exact" : "MISMATCH", check.samples, check.passed() ? "ok" : "FAILED");
+        ok = ok && check.passed();
+    }
+    KernelCheck table = checkKernel(KernelPath::Table);
+    std::printf("%-7s log10 max error %.2e (bound %.2e, %zu segments), %zu samples: %s\n",
+        kernelPathName(KernelPath::Table), table.maxLog10Error, LOG10_TABLE_ERROR_BOUND,
+        log10table::SEGMENTS, table.samples, table.passed() ? "ok" : "FAILED");
+    ok = ok && table.passed();
+    return ok ? 0 : 1;
+}
+
+// 蒙特卡洛场景扫描：并行运行并写出汇总文件
+static int runSweepCommand(const std::string& templatePath, uint64_t firstSeed, uint64_t lastSeed,
+    size_t threads, const std::string& summaryPath, const std::vector<uint8_t>* checkpoint) {
+    Scenario scenario;
+    std::string error;
+    if (!loadScenario(templatePath, scenario, error)) {
+        std::cerr << "Scenario template: " << error << "\n";
+        return 1;
+    }
+    if (lastSeed < firstSeed) {
+        std::cerr << "Invalid seed range\n";
+        return 1;
+    }
+
+    SweepSummary summary = runSweep(scenario, firstSeed, lastSeed, threads, checkpoint);
+    if (!writeSweepSummary(summaryPath, summary)) {
+        std::cerr << "Cannot write sweep summary: " << summaryPath << "\n";
+        return 1;
+    }
+
+    // 汇总统计
+    size_t reachedStable = 0, withAlerts = 0;
+    double stableSum = 0.0, peakEgt = 0.0, fuelSum = 0.0;
+    for (const RunOutcome& run : summary.runs) {
+        if (run.timeToStable >= 0.0) {
+            ++reachedStable;
+            stableSum += run.timeToStable;
+        }
+        if (run.alertCount > 0) ++withAlerts;
+        peakEgt = std::max(peakEgt, run.peakEgt);
+        fuelSum += run.fuelUsed;
+    }
+    const size_t runs = summary.runs.size();
+    std::printf("Swept %zu seeds (%llu..%llu) on %zu threads in %.3f s wall, %.1f runs/s, %llu stolen\n",
+        runs, static_cast<unsigned long long>(firstSeed), static_cast<unsigned long long>(lastSeed),
+        summary.threads, summary.wallSeconds, summary.wallSeconds > 0.0 ? runs / summary.wallSeconds : 0.0,
+        static_cast<unsigned long long>(summary.stolen));
+    std::printf("Reached Stable: %zu (mean %.3f s), with alerts: %zu, peak EGT %.1f, mean fuel used %.1f\n",
+        reachedStable, reachedStable > 0 ? stableSum / reachedStable : 0.0, withAlerts, peakEgt,
+        runs > 0 ? fuelSum / runs : 0.0);
+    std::printf("Summary: %s\n", summaryPath.c_str());
+    return 0;
+}
+
+// 快进查询：启动（或从检查点恢复）后直接跳到指定时刻并打印该时刻的状态
+static int runSeek(double seconds, bool hasSeed, uint64_t seed, const std::vector<uint8_t>* checkpoint) {
+    Simulation simulation;
+    if (hasSeed) simulation.setSeed(seed);
+    if (checkpoint) {
+        restoreCheckpoint(*checkpoint, simulation, nullptr);
+    }
+    else {
+        simulation.apply(Command::Start);
+    }
+    const uint64_t tick = static_cast<uint64_t>(seconds / TIME_STEP + 0.5);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    if (!simulation.seek(tick)) {
+        // 只能向前快进：未运行（检查点保存于未启动或已停车时）或目标不晚于当前时刻
+        std::cerr << "Cannot seek to " << seconds << " s: " << (simulation.isRunning()
+            ? "not after the current time " : "the engine is not running at ") << simulation.time() << " s\n";
+        return 1;
+    }
+    double wallUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wallStart).count();
+
+    const SensorData data = DataGenerator::processData(simulation.data());
+    const char* const phaseNames[] = { "Idle", "Starting", "Stable", "Stopping" };
+    const size_t phase = static_cast<size_t>(data.phase);
+    std::printf("t=%.3f s (tick %llu, %s) reached in %.1f us\n", simulation.time(),
+        static_cast<unsigned long long>(simulation.tick()), phase < 4 ? phaseNames[phase] : "Unknown", wallUs);
+    std::printf("N1 %.2f / %.2f %%, EGT %.1f / %.1f, fuel %.1f, flow %.2f\n", data.n1LeftAverage, data.n1RightAverage,
+        data.egtLeftAverage, data.egtRightAverage, data.fuelLevel, data.fuelFlow);
+    std::printf("Seed: %llu\n", static_cast<unsigned long long>(simulation.seed()));
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    double duration = 600.0;
+    std::string outDir = "DataLogging";
+    std::string scriptPath;
+    bool writeLog = true;
+    bool quiet = false;
+    DataLogFormat format = DataLogFormat::Text;
+    int commitInterval = -1;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    size_t fleetSize = 0;
+    KernelPath kernels = KernelPath::Auto;
+    std::string sweepPath;
+    uint64_t firstSeed = 1, lastSeed = 100;
+    size_t threads = 0;
+    std::string summaryPath = "sweep_summary.csv";
+    std::string recordPath;
+    std::string replayPath;
+    std::string saveCheckpointPath;
+    double checkpointAt = -1.0;
+    std::string restorePath;
+    double seekTime = -1.0;
+    std::string statsPath;
+    std::string tracePath;
+
+    // 解析命令行参数
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--duration" && hasValue) {
+            duration = std::atof(argv[++i]);
+        }
+        else if (arg == "--out" && hasValue) {
+            outDir = argv[++i];
+        }
+        else if (arg == "--script" && hasValue) {
+            scriptPath = argv[++i];
+        }
+        else if (arg == "--format" && hasValue) {
+            std::string value = argv[++i];
+            if (value == "text") format = DataLogFormat::Text;
+            else if (value == "binary") format = DataLogFormat::Binary;
+            else if (value == "both") format = DataLogFormat::Both;
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--trace" && hasValue) {
+            tracePath = argv[++i];
+        }
+        else if (arg == "--stats" && hasValue) {
+            statsPath = argv[++i];
+        }
+        else if (arg == "--commit-interval" && hasValue) {
+            commitInterval = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+            hasSeed = true;
+        }
+        else if (arg == "--fleet" && hasValue) {
+            fleetSize = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--kernels" && hasValue) {
+            std::string value = argv[++i];
+            if (value == "auto") kernels = KernelPath::Auto;
+            else if (value == "scalar") kernels = KernelPath::Scalar;
+            else if (value == "avx2") kernels = KernelPath::Avx2;
+            else if (value == "avx512") kernels = KernelPath::Avx512;
+            else if (value == "table") kernels = KernelPath::Table;
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (arg == "--check-kernels") {
+            return checkKernels();
+        }
+        else if (arg == "--dump" && hasValue) {
+            return dumpTelemetry(argv[++i]);
+        }
+        else if (arg == "--build-pyramid" && hasValue) {
+            return buildPyramid(argv[++i]);
+        }
+        else if (arg == "--trend" && i + 5 < argc) {
+            const std::string path = argv[++i];
+            const std::string channel = argv[++i];
+            const double from = std::atof(argv[++i]);
+            const double to = std::atof(argv[++i]);
+            return printTrend(path, channel, from, to, static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10)));
+        }
+        else if (arg == "--playback" && i + 2 < argc) {
+            const std::string path = argv[++i];
+            return playbackAt(path, std::atof(argv[++i]));
+        }
+        else if (arg == "--sweep" && hasValue) {
+            sweepPath = argv[++i];
+        }
+        else if (arg == "--seeds" && hasValue) {
+            char* end = nullptr;
+            firstSeed = std::strtoull(argv[++i], &end, 10);
+            lastSeed = *end == ':' ? std::strtoull(end + 1, nullptr, 10) : firstSeed;
+        }
+        else if (arg == "--threads" && hasValue) {
+            threads = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--summary" && hasValue) {
+            summaryPath = argv[++i];
+        }
+        else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        }
+        else if (arg == "--save-checkpoint" && hasValue) {
+            saveCheckpointPath = argv[++i];
+        }
+        else if (arg == "--checkpoint-at" && hasValue) {
+            checkpointAt = std::atof(argv[++i]);
+        }
+        else if (arg == "--restore" && hasValue) {
+            restorePath = argv[++i];
+        }
+        else if (arg == "--seek" && hasValue) {
+            seekTime = std::atof(argv[++i]);
+        }
+        else if (arg == "--no-log") {
+            writeLog = false;
+        }
+        else if (arg == "--quiet") {
+            quiet = true;
+        }
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    if (fleetSize > 0) {
+        return runFleet(fleetSize, duration, hasSeed, seed, kernels);
+    }
+
+    // 检查点：先在临时模拟核心上校验，格式不符时直接报错
+    std::vector<uint8_t> checkpoint;
+    if (!restorePath.empty()) {
+        Simulation probe;
+        if (!readCheckpointFile(restorePath, checkpoint) || !restoreCheckpoint(checkpoint, probe, nullptr)) {
+            std::cerr << "Invalid checkpoint: " << restorePath << "\n";
+            return 1;
+        }
+    }
+    const std::vector<uint8_t>* restoreFrom = restorePath.empty() ? nullptr : &checkpoint;
+
+    if (!sweepPath.empty()) {
+        return runSweepCommand(sweepPath, firstSeed, lastSeed, threads, summaryPath, restoreFrom);
+    }
+
+    if (seekTime >= 0.0) {
+        return runSeek(seekTime, hasSeed, seed, restoreFrom);
+    }
+
+    // 指令来源：输入日志回放，或指令脚本（默认在 0 时刻启动）
+    Journal journal;
+    std::vector<ScriptEntry> script;
+    const bool replaying = !replayPath.empty();
+    if (replaying) {
+        std::string error;
+        if (!loadJournal(replayPath, journal, error)) {
+            std::cerr << "Input journal: " << error << "\n";
+            return 1;
+        }
+    }
+    else if (scriptPath.empty() && !restoreFrom) {
+        script.push_back({ 0.0, Command::Start });
+    }
+    else if (!scriptPath.empty() && !loadScript(scriptPath, script)) {
+        return 1;
+    }
+
+    // 模拟核心与日志消费者
+    Simulation simulation;
+    if (replaying) simulation.setSeed(journal.seed);
+    else if (hasSeed) simulation.setSeed(seed);
+    JournalWriter recorder;
+    if (!recordPath.empty()) {
+        if (!recorder.open(recordPath, simulation.seed())) {
+            std::cerr << "Cannot write input journal: " << recordPath << "\n";
+            return 1;
+        }
+        simulation.setCommandCallback([&recorder](uint64_t step, Command command) {
+            recorder.record(step, command);
+        });
+    }
+    SampleRing<Sample> logRing(1024);
+    simulation.addConsumer(&logRing);
+
+    // 各阶段耗时统计（批处理不按真实时间推进，不统计唤醒延迟和超时）
+    TickStats stats;
+    if (!statsPath.empty()) simulation.setStats(&stats);
+
+    Logger logger;
+    if (writeLog) logger.setLogDirectory(outDir);
+    logger.setDataLogFormat(format);
+    if (!statsPath.empty()) logger.setStats(&stats);
+    if (!quiet) {
+        logger.setAlertCallback([](double, AlertLevel, const std::string& text) {
+            std::cout << "[ALERT] " << text << "\n";
+        });
+    }
+
+    // 从检查点恢复（含日志告警去重状态），恢复后的样本从新的日志文件开始记录
+    if (restoreFrom && !replaying) {
+        auto restoreStart = std::chrono::steady_clock::now();
+        restoreCheckpoint(checkpoint, simulation, &logger);
+        double restoreUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - restoreStart).count();
+        std::printf("Restored %s at t=%.3f s in %.1f us\n", restorePath.c_str(), simulation.time(), restoreUs);
+    }
+
+    // 指定组提交间隔时由后台线程写日志；批处理不受实时约束，缓冲区过半时等待写入线程追上，不丢样本
+    if (!tracePath.empty()) {
+        trace::setThreadName("batch");
+        startTracing();
+    }
+    AsyncLogWriter logWriter(logger, logRing);
+    const bool asyncLog = commitInterval >= 0;
+    if (asyncLog) {
+        logWriter.setCommitInterval(commitInterval);
+        logWriter.start();
+    }
+    auto drainLog = [&]() {
+        if (asyncLog) {
+            while (logRing.size() > logRing.capacity() / 2) {
+                std::this_thread::yield();
+            }
+            return;
+        }
+        logRing.drain([&logger](const Sample& sample) { logger.consume(sample); });
+    };
+
+    // 保存检查点：指定时刻（批处理经过的时间）或首次进入稳态时
+    bool checkpointSaved = saveCheckpointPath.empty();
+    auto saveCheckpointIfDue = [&](uint64_t tick) {
+        if (checkpointSaved) return;
+        const bool due = checkpointAt >= 0.0 ? tick * TIME_STEP >= checkpointAt - TIME_STEP * 0.5
+            : simulation.data().phase == EnginePhase::Stable;
+        if (!due) return;
+        checkpointSaved = true;
+        drainLog();
+        auto saveStart = std::chrono::steady_clock::now();
+        // 后台写日志时告警去重状态属于写入线程，不保存
+        const std::vector<uint8_t> bytes = saveCheckpoint(simulation, asyncLog ? nullptr : &logger);
+        double saveUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - saveStart).count();
+        if (!writeCheckpointFile(saveCheckpointPath, bytes)) {
+            std::cerr << "Cannot write checkpoint: " << saveCheckpointPath << "\n";
+            return;
+        }
+        std::printf("Checkpoint %s at t=%.3f s (%zu bytes) in %.1f us\n",
+            saveCheckpointPath.c_str(), simulation.time(), bytes.size(), saveUs);
+    };
+
+    // 以固定步长推进；脚本时间与模拟内部时间无关，按批处理经过的步数计算
+    const uint64_t totalTicks = static_cast<uint64_t>(duration / TIME_STEP + 0.5);
+    uint64_t ticksRun = 0;
+    size_t nextEntry = 0;
+    auto wallStart = std::chrono::steady_clock::now();
+
+    // 回放：指令按记录时的步数执行，没有结束标记的日志以 --duration 为上限
+    JournalPlayer player(journal);
+    if (replaying) {
+        player.setStepLimit(totalTicks);
+        player.begin(simulation);
+        while (player.advance(simulation)) {
+            ++ticksRun;
+            drainLog();
+        }
+    }
+
+    for (uint64_t tick = 0; !replaying && tick < totalTicks; ++tick) {
+        double now = tick * TIME_STEP;
+        while (nextEntry < script.size() && script[nextEntry].time <= now + TIME_STEP * 0.5) {
+            simulation.apply(script[nextEntry].command);
+            ++nextEntry;
+        }
+        saveCheckpointIfDue(tick);
+        drainLog();
+        // 引擎已停且后续没有指令，提前结束
+        if (!simulation.isRunning() && nextEntry >= script.size()) {
+            break;
+        }
+        simulation.step();
+        ++ticksRun;
+    }
+    if (asyncLog) {
+        logWriter.stop();
+    }
+    else {
+        drainLog();
+    }
+    recorder.close(simulation.stepCount());
+    if (player.diverged()) {
+        std::cerr << "Replay diverged from the input journal at step " << simulation.stepCount() << "\n";
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double simulatedSeconds = ticksRun * TIME_STEP;
+    std::printf("Simulated %.3f s (%llu ticks) in %.3f s wall, %.0fx realtime\n",
+        simulatedSeconds, static_cast<unsigned long long>(ticksRun), wallSeconds,
+        wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0);
+    std::printf("Seed: %llu\n", static_cast<unsigned long long>(simulation.seed()));
+    if (writeLog && !logger.baseName().empty()) {
+        const char* dataExtension = format == DataLogFormat::Text ? ".csv"
+            : format == DataLogFormat::Binary ? ".tlm" : ".csv + .tlm";
+        std::printf("Logs: %s%s / %s.log\n", logger.baseName().c_str(), dataExtension, logger.baseName().c_str());
+    }
+    if (!tracePath.empty()) {
+        if (stopTracing(tracePath)) std::printf("Trace: %s\n", tracePath.c_str());
+        else std::cerr << "Cannot write " << tracePath << "\n";
+    }
+    if (!statsPath.empty()) {
+        std::fputs(formatTickStats(stats).c_str(), stdout);
+        if (!writeTickStats(statsPath, stats)) {
+            std::cerr << "Cannot write " << statsPath << "\n";
+        }
+    }
+    return player.diverged() ? 1 : 0;
+}
@@ -0,0 +1,363 @@
+#include "DataGenerator.h"
+#include "Logger.h"
+#include "RuleEngine.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef ENGINE_BENCH_GAUGE
+#include "GaugeWidget.h"
+#include <QApplication>
+#include <QImage>
+#endif
+
+// 基准测试程序：逐项测量每个 5 ms 时间步内的热点（数据生成、处理、异常检测、日志记录、仪表绘制），
+// 结果打印为表格，并可写为 JSON 供持续集成按提交记录和比较。
+// 仪表绘制项需要 Qt，在 Linux 上使用 offscreen 平台渲染到 QImage，不需要显示器
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 防止被测结果被编译器优化掉
+volatile double benchSink = 0.0;
+
+// 一个测试项：每批先执行 prepare（不计时），再连续执行 batch 次 body（计时）
+struct BenchCase {
+    std::string name;
+    size_t batch;
+    std::function<void()> prepare;
+    std::function<void(size_t)> body;
+};
+
+// 一个测试项的结果（单次操作耗时，纳秒）
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    size_t batches = 0;
+    double median = 0.0;
+    double min = 0.0;
+    double mean = 0.0;
+};
+
+// 运行一个测试项：先预热一批，之后至少运行 minBatches 批且累计计时不少于 minTime 秒
+BenchResult runCase(const BenchCase& bench, double minTime) {
+    constexpr size_t minBatches = 5;
+    BenchResult result;
+    result.name = bench.name;
+
+    if (bench.prepare) bench.prepare();
+    bench.body(bench.batch);
+
+    std::vector<double> perOp;
+    double total = 0.0;
+    while (perOp.size() < minBatches || total < minTime) {
+        if (bench.prepare) bench.prepare();
+        const Clock::time_point start = Clock::now();
+        bench.body(bench.batch);
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        total += seconds;
+        perOp.push_back(seconds * 1e9 / static_cast<double>(bench.batch));
+    }
+
+    result.batches = perOp.size();
+    result.iterations = static_cast<uint64_t>(perOp.size()) * bench.batch;
+    result.mean = total * 1e9 / static_cast<double>(result.iterations);
+    std::sort(perOp.begin(), perOp.end());
+    result.min = perOp.front();
+    result.median = perOp[perOp.size() / 2];
+    return result;
+}
+
+// 生成一段真实运行的数据：启动、稳态中加减推力、停车，供处理、检测和日志测试项循环使用
+std::vector<Sample> recordRun(uint64_t seed) {
+    Simulation simulation;
+    simulation.setSeed(seed);
+    SampleRing<Sample> ring(1 << 16);
+    simulation.addConsumer(&ring);
+
+    std::vector<Sample> samples;
+    auto keep = [&samples](const Sample& sample) {
+        if (sample.stepped) samples.push_back(sample);
+    };
+    const struct {
+        double time;
+        Command command;
+    } script[] = {
+        { 0.0, Command::Start },
+        { 20.0, Command::IncreaseThrust },
+        { 23.0, Command::DecreaseThrust },
+        { 30.0, Command::Stop },
+    };
+    size_t next = 0;
+    for (uint64_t tick = 0; tick < static_cast<uint64_t>(45.0 / TIME_STEP); ++tick) {
+        while (next < std::size(script) && script[next].time <= tick * TIME_STEP) {
+            simulation.apply(script[next].command);
+            ++next;
+        }
+        simulation.step();
+        ring.drain(keep);
+    }
+    ring.drain(keep);
+    return samples;
+}
+
+// 使数据生成器进入指定阶段
+DataGenerator generatorIn(EnginePhase phase, uint64_t seed) {
+    DataGenerator generator(seed);
+    if (phase == EnginePhase::Idle) return generator;
+    generator.startSequence();
+    generator.updateData();
+    if (phase == EnginePhase::Starting) return generator;
+    while (generator.getData().phase != EnginePhase::Stable) {
+        generator.updateData();
+    }
+    if (phase == EnginePhase::Stable) return generator;
+    generator.stopSequence();
+    generator.updateData();
+    return generator;
+}
+
+const char* phaseName(EnginePhase phase) {
+    switch (phase) {
+    case EnginePhase::Idle: return "Idle";
+    case EnginePhase::Starting: return "Starting";
+    case EnginePhase::Stable: return "Stable";
+    case EnginePhase::Stopping: return "Stopping";
+    }
+    return "Unknown";
+}
+
+// 模拟核心的测试项
+void addCoreCases(std::vector<BenchCase>& cases, const std::string& logDir) {
+    // 数据生成：每批从该阶段的同一状态开始，批长度小于各阶段的最短持续时间
+    const EnginePhase phases[] = { EnginePhase::Idle, EnginePhase::Starting, EnginePhase::Stable, EnginePhase::Stopping };
+    for (EnginePhase phase : phases) {
+        auto snapshot = std::make_shared<DataGenerator>(generatorIn(phase, 1));
+        auto generator = std::make_shared<DataGenerator>(*snapshot);
+        cases.push_back({ std::string("updateData/") + phaseName(phase), 256,
+            [snapshot, generator]() { *generator = *snapshot; },
+            [generator, phase](size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    generator->updateData();
+                }
+                if (generator->getData().phase != phase) {
+                    std::cerr << "updateData/" << phaseName(phase) << ": batch left the phase\n";
+                }
+                benchSink = generator->getData().n1LeftAverage;
+            } });
+    }
+
+    auto samples = std::make_shared<std::vector<Sample>>(recordRun(1));
+
+    cases.push_back({ "processData", 4096, nullptr,
+        [samples](size_t count) {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i) {
+                sum += DataGenerator::processData((*samples)[i % samples->size()].data).egtLeftAverage;
+            }
+            benchSink = sum;
+        } });
+
+    // 异常检测：模拟核心每步的检测（规则表求值 + 传感器故障告警），即原 checkData
+    cases.push_back({ "checkData", 4096, nullptr,
+        [samples](size_t count) {
+            AnomalyState anomaly;
+            uint32_t alerts = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const RuleOutcome outcome = evaluateRules((*samples)[i % samples->size()].data, anomaly);
+                alerts ^= outcome.alerts | sensorAlerts(anomaly);
+            }
+            benchSink = alerts;
+        } });
+
+    // 日志记录：写入临时目录下的真实文件；每批重新建立日志文件，文件大小不随运行时间增长
+    struct LogState {
+        Logger logger;
+        double time = 0.0;
+    };
+    const bool withFaults[] = { false, true };
+    for (bool faults : withFaults) {
+        auto state = std::make_shared<LogState>();
+        state->logger.setLogDirectory(logDir);
+        AnomalyState anomaly;
+        uint32_t faultAlerts = 0;
+        if (faults) {
+            anomaly.N1LS1Fail = anomaly.N1LS2Fail = true;
+            anomaly.EGTRS1Fail = true;
+            anomaly.EGTOverSpeedLevel = 3;
+            faultAlerts = sensorAlerts(anomaly) | alertBit(AlertId::EGTOverTempStable3);
+        }
+        cases.push_back({ faults ? "logDataAndAlerts/faults" : "logDataAndAlerts/normal", 4096,
+            [state, logDir]() { state->logger.initLogFile(logDir); },
+            [state, samples, anomaly, faultAlerts](size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    const Sample& sample = (*samples)[i % samples->size()];
+                    state->time += TIME_STEP;
+                    state->logger.logDataAndAlerts(state->time, DataGenerator::processData(sample.data),
+                        anomaly, sample.alerts | faultAlerts);
+                }
+                state->logger.flush();
+            } });
+    }
+}
+
+#ifdef ENGINE_BENCH_GAUGE
+// 仪表绘制的测试项：指针每帧移动（静态表盘走缓存），以及告警等级每帧变化（静态表盘每帧重绘）
+void addGaugeCases(std::vector<BenchCase>& cases) {
+    struct GaugeState {
+        GaugeWidget gauge{ GaugeWidget::N1 };
+        QImage image;
+        size_t frame = 0;
+    };
+    const bool levelChanges[] = { false, true };
+    for (bool changeLevel : levelChanges) {
+        auto state = std::make_shared<GaugeState>();
+        state->gauge.resize(300, 300);
+        state->image = QImage(state->gauge.size(), QImage::Format_ARGB32_Premultiplied);
+        cases.push_back({ changeLevel ? "GaugeWidget::paintEvent/dial" : "GaugeWidget::paintEvent/cached", 64, nullptr,
+            [state, changeLevel](size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    ++state->frame;
+                    state->gauge.updateValue(static_cast<double>(state->frame % 1000) * 0.1);
+                    if (changeLevel) {
+                        state->gauge.updateLevel(state->frame % 2 ? AlertLevel::amberWarning : AlertLevel::normal);
+                    }
+                    state->gauge.render(&state->image);
+                }
+                benchSink = state->image.pixel(150, 150);
+            } });
+    }
+}
+#endif
+
+// JSON 字符串转义
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+// 将结果写为 JSON（path 为 "-" 时写到标准输出）
+bool writeJson(const std::string& path, const std::string& label, const std::vector<BenchResult>& results) {
+    std::FILE* file = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fprintf(file, "{\n  \"label\": %s,\n  \"unit\": \"ns/op\",\n  \"cases\": [\n", jsonString(label).c_str());
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::fprintf(file, "    { \"name\": %s, \"iterations\": %llu, \"batches\": %zu, "
+            "\"median\": %.3f, \"min\": %.3f, \"mean\": %.3f }%s\n",
+            jsonString(r.name).c_str(), static_cast<unsigned long long>(r.iterations), r.batches,
+            r.median, r.min, r.mean, i + 1 < results.size() ? "," : "");
+    }
+    std::fputs("  ]\n}\n", file);
+    if (file == stdout) return std::fflush(file) == 0;
+    return std::fclose(file) == 0;
+}
+
+// 打印用法
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+        << "  --filter <text>   run only cases whose name contains <text>\n"
+        << "  --min-time <s>    timed seconds per case, at least 5 batches (default 0.5)\n"
+        << "  --json <file>     write results as JSON (\"-\" for stdout)\n"
+        << "  --label <text>    label stored in the JSON, e.g. the commit hash\n"
+        << "  --list            list the cases and exit\n"
+#ifndef ENGINE_BENCH_GAUGE
+        << "GaugeWidget cases are only built when Qt 6 Widgets is available.\n"
+#endif
+        ;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    double minTime = 0.5;
+    std::string jsonPath;
+    std::string label;
+    bool listOnly = false;
+
+    // 解析命令行参数
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        }
+        else if (arg == "--min-time" && hasValue) {
+            minTime = std::atof(argv[++i]);
+        }
+        else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        }
+        else if (arg == "--label" && hasValue) {
+            label = argv[++i];
+        }
+        else if (arg == "--list") {
+            listOnly = true;
+        }
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+#ifdef ENGINE_BENCH_GAUGE
+    // 未指定平台时使用 offscreen，无显示器的机器上也能运行
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+#endif
+
+    // 日志测试项的临时目录，结束时删除
+    const std::filesystem::path logDir = std::filesystem::temp_directory_path() / "EngineBench";
+
+    std::vector<BenchCase> cases;
+    addCoreCases(cases, logDir.string());
+#ifdef ENGINE_BENCH_GAUGE
+    addGaugeCases(cases);
+#endif
+
+    std::vector<BenchResult> results;
+    // 表格在写 JSON 到标准输出时改写到标准错误
+    std::FILE* table = jsonPath == "-" ? stderr : stdout;
+    if (!listOnly) {
+        std::fprintf(table, "%-32s %12s %12s %12s %12s\n", "case", "iterations", "median ns", "min ns", "mean ns");
+    }
+    for (const BenchCase& bench : cases) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) continue;
+        if (listOnly) {
+            std::printf("%s\n", bench.name.c_str());
+            continue;
+        }
+        const BenchResult result = runCase(bench, minTime);
+        std::fprintf(table, "%-32s %12llu %12.1f %12.1f %12.1f\n", result.name.c_str(),
+            static_cast<unsigned long long>(result.iterations), result.median, result.min, result.mean);
+        std::fflush(table);
+        results.push_back(result);
+    }
+    // 先释放测试项（关闭日志文件），再删除临时目录
+    cases.clear();
+    std::error_code ec;
+    std::filesystem::remove_all(logDir, ec);
+
+    if (!jsonPath.empty() && !listOnly && !writeJson(jsonPath, label, results)) {
+        std::cerr << "Cannot write " << jsonPath << "\n";
+        return 1;
+    }
+    return 0;
+}
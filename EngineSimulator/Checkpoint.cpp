@@ -0,0 +1,78 @@
+#include "Checkpoint.h"
+#include "Logger.h"
+#include "Simulation.h"
+#include <cstdio>
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[8] = { 'E', 'S', 'C', 'K', 'P', '0', '1', '\0' };
+constexpr uint32_t CHECKPOINT_VERSION = 2;
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t rngStateSize;   // 随机数发生器状态大小，换用其他策略的构建读取时据此拒绝
+};
+
+} // namespace
+
+// 保存检查点
+std::vector<uint8_t> saveCheckpoint(const Simulation& simulation, const Logger* logger) {
+    CheckpointWriter writer;
+    CheckpointHeader header = {};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.rngStateSize = static_cast<uint32_t>(sizeof(Xoshiro256PlusPlus));
+    writer.put(header);
+
+    simulation.saveState(writer);
+    writer.put(static_cast<uint8_t>(logger ? 1 : 0));
+    if (logger) logger->saveAlertState(writer);
+    return writer.take();
+}
+
+// 恢复检查点：没有日志段的检查点恢复到带日志的运行时，去重状态按新运行处理
+bool restoreCheckpoint(const std::vector<uint8_t>& bytes, Simulation& simulation, Logger* logger) {
+    CheckpointReader reader(bytes.data(), bytes.size());
+    CheckpointHeader header;
+    if (!reader.get(header) || std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0
+        || header.version != CHECKPOINT_VERSION || header.rngStateSize != sizeof(Xoshiro256PlusPlus)) {
+        return false;
+    }
+    if (!simulation.loadState(reader)) return false;
+
+    uint8_t hasLogger = 0;
+    if (!reader.get(hasLogger)) return false;
+    if (hasLogger) {
+        if (logger) {
+            if (!logger->loadAlertState(reader)) return false;
+        }
+        else {
+            Logger discard;
+            if (!discard.loadAlertState(reader)) return false;
+        }
+    }
+    return reader.atEnd();
+}
+
+// 检查点文件读写
+bool writeCheckpointFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && written;
+}
+
+bool readCheckpointFile(const std::string& path, std::vector<uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    bytes.clear();
+    uint8_t chunk[4096];
+    size_t count;
+    while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        bytes.insert(bytes.end(), chunk, chunk + count);
+    }
+    const bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
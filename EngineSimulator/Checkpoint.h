@@ -0,0 +1,100 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class Simulation;
+class Logger;
+
+// 模拟状态检查点（.ckp）
+// 紧凑的二进制快照：模拟核心（数据、异常状态、时间与步数）、机队生成器的全部通道和随机数发生器状态，
+// 以及日志告警去重时间。从检查点恢复后继续推进得到与原运行逐位相同的数据和告警，
+// 可用于跳过启动阶段直接测试稳态，或从同一状态分叉出多次运行。
+// 快照按内存布局原样保存，只保证同一构建的程序之间互相读取。
+//
+// 格式：magic "ESCKP01\0"、版本、随机数发生器状态大小，之后依次为
+//   Simulation、DataGenerator（机队）、Logger（有无标志 + 去重时间）各段
+
+// 检查点写入缓冲区
+class CheckpointWriter {
+public:
+    // 定长值按内存布局写入
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        const size_t old = buffer.size();
+        buffer.resize(old + sizeof(T));
+        std::memcpy(buffer.data() + old, &value, sizeof(T));
+    }
+
+    // 数组先写长度再写内容
+    template <typename T>
+    void putVector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        put(static_cast<uint64_t>(values.size()));
+        if (values.empty()) return;
+        const size_t old = buffer.size();
+        buffer.resize(old + values.size() * sizeof(T));
+        std::memcpy(buffer.data() + old, values.data(), values.size() * sizeof(T));
+    }
+
+    const std::vector<uint8_t>& bytes() const { return buffer; }
+    std::vector<uint8_t> take() { return std::move(buffer); }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+// 检查点读取游标，越界时返回 false 且不修改目标
+class CheckpointReader {
+public:
+    CheckpointReader(const uint8_t* data, size_t size) : cursor(data), end(data + size) {
+    }
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        if (static_cast<size_t>(end - cursor) < sizeof(T)) return false;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    // expected 非零时长度必须与之相同
+    template <typename T>
+    bool getVector(std::vector<T>& values, size_t expected = 0) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        uint64_t count = 0;
+        if (!get(count)) return false;
+        if (expected != 0 && count != expected) return false;
+        if (count > static_cast<size_t>(end - cursor) / sizeof(T)) return false;
+        values.resize(static_cast<size_t>(count));
+        std::memcpy(values.data(), cursor, static_cast<size_t>(count) * sizeof(T));
+        cursor += static_cast<size_t>(count) * sizeof(T);
+        return true;
+    }
+
+    bool atEnd() const { return cursor == end; }
+
+private:
+    const uint8_t* cursor;
+    const uint8_t* end;
+};
+
+// 保存模拟核心（及可选的日志告警去重状态）为检查点
+std::vector<uint8_t> saveCheckpoint(const Simulation& simulation, const Logger* logger);
+
+// 从检查点恢复；格式不符时返回 false，模拟核心状态不确定，应重新恢复或 reset()
+bool restoreCheckpoint(const std::vector<uint8_t>& bytes, Simulation& simulation, Logger* logger);
+
+// 检查点文件读写
+bool writeCheckpointFile(const std::string& path, const std::vector<uint8_t>& bytes);
+bool readCheckpointFile(const std::string& path, std::vector<uint8_t>& bytes);
+
+#endif // CHECKPOINT_H
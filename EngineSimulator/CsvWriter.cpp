@@ -0,0 +1,155 @@
+#include "CsvWriter.h"
+#include "TelemetryLog.h"
+#include <charconv>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// 各数值列的小数位数（与原文本日志一致）：N1 两位，EGT、燃油一位
+constexpr int VALUE_DECIMALS[CsvWriter::VALUE_COLUMNS] = { 2, 2, 1, 1, 1, 1 };
+
+// 可能输出 N/A 的列对应的有效位，燃油两列始终输出数值
+constexpr uint8_t VALUE_VALID_BITS[CsvWriter::VALUE_COLUMNS] = {
+    VALID_N1_LEFT, VALID_N1_RIGHT, VALID_EGT_LEFT, VALID_EGT_RIGHT, 0, 0
+};
+
+// 时间戳保留三位小数（5ms 步长）
+constexpr int TIME_DECIMALS = 3;
+
+constexpr long long POW10[] = { 1, 10, 100, 1000 };
+
+// 定点格式化：放大后四舍五入为整数，整数部分和小数部分分别用 to_chars 输出；
+// 超出整数范围或非有限值时退回科学计数法（长度有界，任何输入都不超过一行的预留空间），仍失败时输出 N/A
+char* formatFixed(char* out, char* end, double value, int decimals) {
+    const double scaled = value * static_cast<double>(POW10[decimals]);
+    if (!(std::fabs(scaled) < 9.0e15)) {
+        const std::to_chars_result result = std::to_chars(out, end, value, std::chars_format::scientific, decimals);
+        if (result.ec == std::errc()) return result.ptr;
+        *out++ = 'N';
+        *out++ = '/';
+        *out++ = 'A';
+        return out;
+    }
+    long long n = std::llround(scaled);
+    if (n < 0) {
+        *out++ = '-';
+        n = -n;
+    }
+    out = std::to_chars(out, end, n / POW10[decimals]).ptr;
+    if (decimals > 0) {
+        *out++ = '.';
+        long long fraction = n % POW10[decimals];
+        for (int i = decimals - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        out += decimals;
+    }
+    return out;
+}
+
+} // namespace
+
+// 表头
+const char* CsvWriter::header() {
+    return "Timestamp(s),N1LeftAverage,N1RightAverage,EGTLeftAverage,EGTRightAverage,FuelLevel,FuelFlow,Phase\n";
+}
+
+// 构造与析构
+CsvWriter::CsvWriter(size_t bufferSize)
+    : file(nullptr), ownsFile(false), buffer(bufferSize < MAX_ROW_LENGTH * 4 ? MAX_ROW_LENGTH * 4 : bufferSize), used(0) {
+}
+CsvWriter::~CsvWriter() {
+    close();
+}
+
+// 创建文件并写入表头
+bool CsvWriter::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open data log file: " << path << "\n";
+        return false;
+    }
+    ownsFile = true;
+    std::fputs(header(), file);
+    return true;
+}
+
+// 写入已打开的流
+void CsvWriter::attach(std::FILE* stream) {
+    close();
+    file = stream;
+    ownsFile = false;
+    std::fputs(header(), file);
+}
+
+// 格式化一行
+size_t CsvWriter::formatRow(char* out, double time, const double values[VALUE_COLUMNS],
+    EnginePhase phase, uint8_t valid) {
+    char* const begin = out;
+    char* const end = out + MAX_ROW_LENGTH;
+    out = formatFixed(out, end, time, TIME_DECIMALS);
+    for (int c = 0; c < VALUE_COLUMNS; ++c) {
+        *out++ = ',';
+        if (VALUE_VALID_BITS[c] && !(valid & VALUE_VALID_BITS[c])) {
+            *out++ = 'N';
+            *out++ = '/';
+            *out++ = 'A';
+        }
+        else {
+            out = formatFixed(out, end, values[c], VALUE_DECIMALS[c]);
+        }
+    }
+    *out++ = ',';
+    out = std::to_chars(out, end, static_cast<int>(phase)).ptr;
+    *out++ = '\n';
+    return static_cast<size_t>(out - begin);
+}
+
+// 追加一行
+void CsvWriter::appendRow(double time, const SensorData& data, uint8_t valid) {
+    const double values[VALUE_COLUMNS] = {
+        data.n1LeftAverage, data.n1RightAverage, data.egtLeftAverage,
+        data.egtRightAverage, data.fuelLevel, data.fuelFlow
+    };
+    appendRow(time, values, data.phase, valid);
+}
+
+void CsvWriter::appendRow(double time, const double values[VALUE_COLUMNS], EnginePhase phase, uint8_t valid) {
+    if (!file) return;
+    reserveRow();
+    used += formatRow(buffer.data() + used, time, values, phase, valid);
+}
+
+// 缓冲区剩余空间不足一行时写出
+void CsvWriter::reserveRow() {
+    if (buffer.size() - used < MAX_ROW_LENGTH) {
+        std::fwrite(buffer.data(), 1, used, file);
+        used = 0;
+    }
+}
+
+// 将缓冲区写入文件
+void CsvWriter::flush() {
+    if (!file) return;
+    if (used > 0) {
+        std::fwrite(buffer.data(), 1, used, file);
+        used = 0;
+    }
+    std::fflush(file);
+}
+
+// 写出剩余数据并关闭
+void CsvWriter::close() {
+    if (!file) return;
+    flush();
+    if (ownsFile) std::fclose(file);
+    file = nullptr;
+    ownsFile = false;
+}
+
+bool CsvWriter::isOpen() const {
+    return file != nullptr;
+}
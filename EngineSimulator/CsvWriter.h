@@ -0,0 +1,63 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include "EngineState.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 数据日志 CSV 写入器
+// 每行严格对应表头的 8 列，数值用 std::to_chars 直接格式化到复用的字节缓冲区，
+// 写满后整块写出，逐行记录不产生任何堆分配。
+// 传感器全部故障的 N1/EGT 列输出 N/A（有效位定义见 TelemetryLog.h）
+class CsvWriter {
+public:
+    // 数值列顺序与 TelemetryChannel 一致
+    static constexpr int VALUE_COLUMNS = 6;
+
+    // 单行最大长度
+    static constexpr size_t MAX_ROW_LENGTH = 256;
+
+    // 表头
+    static const char* header();
+
+    explicit CsvWriter(size_t bufferSize = 1 << 20);
+    ~CsvWriter();
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    // 创建文件并写入表头
+    bool open(const std::string& path);
+
+    // 写入已打开的流（如标准输出），不负责关闭
+    void attach(std::FILE* stream);
+
+    // 追加一行
+    void appendRow(double time, const SensorData& data, uint8_t valid);
+    void appendRow(double time, const double values[VALUE_COLUMNS], EnginePhase phase, uint8_t valid);
+
+    // 将缓冲区写入文件
+    void flush();
+
+    // 写出剩余数据并关闭
+    void close();
+
+    bool isOpen() const;
+
+    // 格式化一行到 out（至少 MAX_ROW_LENGTH 字节），返回长度
+    static size_t formatRow(char* out, double time, const double values[VALUE_COLUMNS],
+        EnginePhase phase, uint8_t valid);
+
+private:
+    // 缓冲区剩余空间不足一行时写出
+    void reserveRow();
+
+    std::FILE* file;
+    bool ownsFile;
+    std::vector<char> buffer;
+    size_t used;
+};
+
+#endif // CSVWRITER_H
@@ -1,150 +1,110 @@
 #include "DataGenerator.h"
-#include <QRandomGenerator>
-#include <cmath>
-#include <qdebug.h>
+#include "SpanTrace.h"
+
+// 左右发动机在机队中的编号
+static constexpr size_t LEFT_ENGINE = 0;
+static constexpr size_t RIGHT_ENGINE = 1;
+
+// 构造函数初始化：一组两台发动机
+template <typename Rng>
+BasicDataGenerator<Rng>::BasicDataGenerator(uint64_t seed)
+    : fleet(2, 2, seed) {
+    // 两台发动机无需向量化，固定使用标量内核，同一种子在任何机器上得到相同数据
+    fleet.setKernelPath(KernelPath::Scalar);
+}
 
-// 构造函数初始化
-DataGenerator::DataGenerator() {
-    data = SensorData();
-    auxData = SensorData();
-    increaseThrust = false;
-    decreaseThrust = false;
+// 重新播种
+template <typename Rng>
+void BasicDataGenerator<Rng>::seed(uint64_t value) {
+    fleet.seed(value);
+}
+template <typename Rng>
+uint64_t BasicDataGenerator<Rng>::seedValue() const {
+    return fleet.seedValue();
 }
 
 // 控制接口实现
-void DataGenerator::startSequence() {
-    if (data.phase == EnginePhase::Idle) {
-        data.phase = EnginePhase::Starting;
-        data.elapsedTime = 0.0; // 重置时间
-    }
+template <typename Rng>
+void BasicDataGenerator<Rng>::startSequence() {
+    fleet.startSequence(0);
 }
-void DataGenerator::stopSequence() {
-    if (data.phase != EnginePhase::Idle && data.phase != EnginePhase::Stopping) {
-        data.lastPhase = data.phase;
-        data.phase = EnginePhase::Stopping;
-        data.fuelFlow = 0.0;
-        auxData = data; // 保存停车瞬间的状态作为衰减起点
-    }
+template <typename Rng>
+void BasicDataGenerator<Rng>::stopSequence() {
+    fleet.stopSequence(0);
 }
-void DataGenerator::setIncreaseThrust(bool val) {
-    increaseThrust = val;
+template <typename Rng>
+void BasicDataGenerator<Rng>::setIncreaseThrust(bool val) {
+    fleet.setIncreaseThrust(0, val);
 }
-void DataGenerator::setDecreaseThrust(bool val) {
-    decreaseThrust = val;
+template <typename Rng>
+void BasicDataGenerator<Rng>::setDecreaseThrust(bool val) {
+    fleet.setDecreaseThrust(0, val);
 }
 
 // 内部更新数据函数
-void DataGenerator::updateData() {
-    // 燃油余量更新
-    auxData.fuelLevel = data.fuelLevel -= data.fuelFlow * TIME_STEP;
-    // 更新时间
-    data.elapsedTime += TIME_STEP;
-
-	// 根据当前阶段更新数据
-    switch (data.phase) {
-        // 保持不变
-    case EnginePhase::Idle:
-        break;
-        // 启动阶段
-    case EnginePhase::Starting:
-        if (data.elapsedTime < 2.0) {
-            // 线性增长
-            data.n1LeftAverage = data.n1RightAverage = 10000.0 * data.elapsedTime * 100.0 / RATED_RPM;
-            data.egtLeftAverage = data.egtRightAverage = TEMPRATURE;
-            data.fuelFlow = 5.0 * data.elapsedTime;
-        }
-        else {
-            data.n1LeftAverage = data.n1RightAverage = 23000.0 * std::log10(data.elapsedTime - 1.0) * 100.0 / RATED_RPM + 50.0;
-            data.egtLeftAverage = data.egtRightAverage = 900.0 * std::log10(data.elapsedTime - 1.0) + TEMPRATURE;
-            data.fuelFlow = 42 * std::log10(data.elapsedTime - 1.0) + 10.0;
-        }
-        // 处理超温1状态
-        if (data.EGTOverSpeed1) {
-            data.egtLeftAverage += 840.0;
-            data.egtRightAverage += 840.0;
-        }
-        break;
-
-        // 达到稳态
-    case EnginePhase::Stable:
-        data = auxData;
-        break;
-
-        // 停车阶段
-    case EnginePhase::Stopping:
-        // 自定义对数衰减函数，底数为0.05
-        double stopTime = data.elapsedTime - auxData.elapsedTime;
-
-        data.n1LeftAverage = auxData.n1LeftAverage * std::log10(0.05 + 15.0 * stopTime / auxData.n1LeftAverage) / std::log10(0.05);
-        data.n1RightAverage = auxData.n1RightAverage * std::log10(0.05 + 15.0 * stopTime / auxData.n1RightAverage) / std::log10(0.05);
-        data.egtLeftAverage = (auxData.egtLeftAverage - TEMPRATURE) * std::log10(0.05 + 150.0 * stopTime / auxData.egtLeftAverage) / std::log10(0.05) + TEMPRATURE;
-        data.egtRightAverage = (auxData.egtRightAverage - TEMPRATURE) * std::log10(0.05 + 150.0 * stopTime / auxData.egtRightAverage) / std::log10(0.05) + TEMPRATURE;
-        break;
-    }
-
-    // 处理推力偏移量
-    if (increaseThrust) {
-        auxData.fuelFlow += 1.0; // 每次增加1 lbs/s
-        auxData.n1RightAverage = auxData.n1LeftAverage *= (1 + QRandomGenerator::global()->bounded(0.02) + 0.03);
-        auxData.egtLeftAverage = auxData.egtRightAverage *= (1 + QRandomGenerator::global()->bounded(0.02) + 0.03);
-        increaseThrust = false; // 重置标志
-    }
-    if (decreaseThrust) {
-        auxData.fuelFlow -= 1.0; // 每次减少1 lbs/s
-        auxData.n1RightAverage = auxData.n1LeftAverage *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.05);
-        auxData.egtLeftAverage = auxData.egtRightAverage *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.05);
-        decreaseThrust = false; // 重置标志
-    }
-
-    // 随机扰动，所有噪声均分布在±2%内
-    data.n1LeftAverage *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.01);
-    data.n1RightAverage *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.01);
-    data.egtLeftAverage *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.01);
-    data.egtRightAverage *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.01);
-    data.fuelFlow *= (1 + QRandomGenerator::global()->bounded(0.02) - 0.01);
+template <typename Rng>
+void BasicDataGenerator<Rng>::updateData() {
+    TRACE_SPAN("updateData");
+    fleet.step();
+}
 
-    // 检查并更新阶段
-    checkPhase();
+// 快进
+template <typename Rng>
+void BasicDataGenerator<Rng>::advance(uint64_t steps) {
+    fleet.seek(fleet.stepCount() + steps);
 }
 
-// 更新数据外部接口
-void DataGenerator::updateData(const SensorData& newData) {
-    data = auxData = newData;
+// 更新数据外部接口：写入两台发动机，同时作为稳态/停车的起点
+template <typename Rng>
+void BasicDataGenerator<Rng>::updateData(const SensorData& newData) {
+    fleet.setEngine(LEFT_ENGINE, newData.n1LeftAverage, newData.egtLeftAverage, newData.fuelFlow,
+        newData.fuelLevel, newData.phase, newData.lastPhase, newData.elapsedTime, newData.EGTOverSpeed1);
+    fleet.setEngine(RIGHT_ENGINE, newData.n1RightAverage, newData.egtRightAverage, newData.fuelFlow,
+        newData.fuelLevel, newData.phase, newData.lastPhase, newData.elapsedTime, newData.EGTOverSpeed1);
 }
 
 // 获取当前数据
-SensorData DataGenerator::getData() {
+template <typename Rng>
+SensorData BasicDataGenerator<Rng>::getData() {
+    SensorData data;
+    data.n1LeftAverage = fleet.n1()[LEFT_ENGINE];
+    data.n1RightAverage = fleet.n1()[RIGHT_ENGINE];
+    data.egtLeftAverage = fleet.egt()[LEFT_ENGINE];
+    data.egtRightAverage = fleet.egt()[RIGHT_ENGINE];
+    data.fuelLevel = fleet.fuelLevel()[LEFT_ENGINE];
+    data.fuelFlow = fleet.fuelFlow()[LEFT_ENGINE];
+    data.phase = static_cast<EnginePhase>(fleet.phase()[LEFT_ENGINE]);
+    data.lastPhase = static_cast<EnginePhase>(fleet.lastPhase()[LEFT_ENGINE]);
+    data.elapsedTime = fleet.elapsedTime()[LEFT_ENGINE];
+    data.EGTOverSpeed1 = fleet.egtOverTemp()[LEFT_ENGINE] != 0;
     return data;
 }
 
 // 检查并更新阶段
-void DataGenerator::checkPhase() {
-    // 根据当前数据和条件检查并更新阶段
-    if (data.phase == EnginePhase::Starting && (data.n1LeftAverage >= 95.0 && data.n1RightAverage >= 95.0)) {
-        data.phase = EnginePhase::Stable;
-        // 保存稳态数据到辅助变量
-        auxData = data;
-    }
-    else if (data.phase == EnginePhase::Stopping) {
-        double stopTime = data.elapsedTime - auxData.elapsedTime;
+template <typename Rng>
+void BasicDataGenerator<Rng>::checkPhase() {
+    fleet.checkPhase();
+}
 
-        // 条件1：停车时间超过10秒
-        // 条件2：转速已降到很低（< 1%）
-        if (stopTime >= STOP_DURATION || (data.n1LeftAverage <= 0.1 && data.n1RightAverage <= 0.1
-            && data.egtLeftAverage <= (TEMPRATURE + 0.5)) && data.egtRightAverage <= (TEMPRATURE + 0.5)) {
-            data.phase = EnginePhase::Idle;
-            // 重置所有值到完全停止状态
-            data.n1LeftAverage = data.n1RightAverage = 0.0;
-            data.egtLeftAverage = data.egtRightAverage = TEMPRATURE; // 回到室温
-            data.fuelFlow = 0.0;
+// 检查点：双发视图本身没有额外状态
+template <typename Rng>
+void BasicDataGenerator<Rng>::saveState(CheckpointWriter& writer) const {
+    fleet.saveState(writer);
+}
+template <typename Rng>
+bool BasicDataGenerator<Rng>::loadState(CheckpointReader& reader) {
+    return fleet.loadState(reader);
+}
 
-            data.EGTOverSpeed1 = false;
-        }
-    }
+// 底层机队生成器
+template <typename Rng>
+const BasicFleetGenerator<Rng>& BasicDataGenerator<Rng>::fleetGenerator() const {
+    return fleet;
 }
 
 // 处理数据
-SensorData DataGenerator::processData(const SensorData& inputData) {
+template <typename Rng>
+SensorData BasicDataGenerator<Rng>::processData(const SensorData& inputData) {
     SensorData outputData = inputData;
     if(outputData.fuelLevel < 0.0) {
         outputData.fuelLevel = 0.0;
@@ -162,4 +122,8 @@ SensorData DataGenerator::processData(const SensorData& inputData) {
         outputData.egtRightAverage = TEMPRATURE;
 	}
     return outputData;
-}
\ No newline at end of file
+}
+
+// 显式实例化：默认 xoshiro256++，另提供标准库 mt19937_64 策略
+template class BasicDataGenerator<Xoshiro256PlusPlus>;
+template class BasicDataGenerator<std::mt19937_64>;
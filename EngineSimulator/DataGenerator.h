@@ -2,12 +2,22 @@
 #define DATAGENERATOR_H
 
 #include "EngineState.h"
-#include <QVector>
+#include "FleetGenerator.h"
+#include "Random.h"
 
 // 数据生成器类
-class DataGenerator {
+// 双发视图：数据由 2 台 1 组的机队生成器产生，左发为 0 号、右发为 1 号，
+// 燃油余量和燃油流速取 0 号发动机。
+// 推力调整的随机偏移由模板参数 Rng 指定的发生器产生（策略要求见 Random.h），每个实例独立播种；
+// 数据噪声为按步数索引的计数器随机数，可用 advance() 直接跳到之后任意一步
+template <typename Rng>
+class BasicDataGenerator {
 public:
-    DataGenerator();
+    explicit BasicDataGenerator(uint64_t seed = randomSeed());
+
+    // 重新播种（相同种子 + 相同指令序列得到逐位相同的数据）
+    void seed(uint64_t value);
+    uint64_t seedValue() const;
 
 	// 控制接口
     void startSequence();
@@ -19,23 +29,31 @@ public:
     void updateData();
     void updateData(const SensorData& newData);
 
+    // 推进 steps 步（为 0 时不变），与连续调用 updateData() 逐位一致，不会切换阶段的区间直接跳过（见 FleetGenerator::seek）
+    void advance(uint64_t steps);
+
 	// 检查并更新阶段
     void checkPhase();
 
 	// 获取当前数据
     SensorData getData();
 
-    // 处理数据
-	SensorData processData(const SensorData& inputData);
+    // 处理数据（无状态，可供各数据消费者直接调用）
+	static SensorData processData(const SensorData& inputData);
 
-private:
-    // 数据和辅助数据
-    SensorData data , auxData;
+    // 检查点
+    void saveState(CheckpointWriter& writer) const;
+    bool loadState(CheckpointReader& reader);
 
-    // 是否增加推力
-    bool increaseThrust;  
-    // 是否减小推力
-    bool decreaseThrust;  
+    // 底层机队生成器
+    const BasicFleetGenerator<Rng>& fleetGenerator() const;
+
+private:
+    // 左右两台发动机
+    BasicFleetGenerator<Rng> fleet;
 };
 
+// 默认使用 xoshiro256++
+using DataGenerator = BasicDataGenerator<Xoshiro256PlusPlus>;
+
 #endif // DATAGENERATOR_H
\ No newline at end of file
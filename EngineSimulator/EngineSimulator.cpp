@@ -1,23 +1,42 @@
 #include "EngineSimulator.h"
-#include "DataGenerator.h"
-#include "Logger.h"
 #include "EngineState.h"
+#include "UiStyle.h"
+#include "SpanTrace.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
 #include <QTimer>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QAction>
+#include <QFontDatabase>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <cmath>
+
+// 回放倍速
+static constexpr double PLAYBACK_SPEEDS[] = { 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 64.0 };
 
 // 构造函数
 EngineSimulator::EngineSimulator(QWidget* parent)
-	: QMainWindow(parent), TheGlobalTime(0.0)
+	: QMainWindow(parent)
 	, ui(new Ui::EngineSimulatorClass)
-    , simulationTimer(new QTimer(this))
-    , displayTimer(new QTimer(this)), anomalyState()
+    , refreshTimer(new QTimer(this))
+    , displayTimer(new QTimer(this))
+    , simulationThread(new SimulationThread(this))
+    , statsTimer(new QTimer(this)), statsSeconds(0)
+    , playbackMode(false), playbackPlaying(false), playbackTime(0.0), playbackSpeed(1.0), playbackAlerts(0)
+    , displayRing(1024), logRing(16384), logWriter(logger, logRing), currentTime(0.0), anomalyState()
+    , shownIndicator(-1), shownFuelFlowState(-1)
 {
 	// 设置UI
     ui->setupUi(this);
 
-    // 5ms 定时器 - 数据生成
-    simulationTimer->setInterval(5);
-    connect(simulationTimer, &QTimer::timeout, this, &EngineSimulator::onSimulateTimerTimeout);
+    // 按显示刷新率读取模拟线程发布的最新样本并刷新界面
+    refreshTimer->setTimerType(Qt::PreciseTimer);
+    setRefreshRate(60);
+    connect(refreshTimer, &QTimer::timeout, this, &EngineSimulator::onRefreshTimerTimeout);
 
     // 1秒 定时器 - UI 显示
     displayTimer->setInterval(1000);
@@ -55,9 +74,15 @@ EngineSimulator::EngineSimulator(QWidget* parent)
     connect(ui->LowFuel, &QPushButton::clicked, this, &EngineSimulator::onLowFuelClicked);
     connect(ui->FFOverSpeed, &QPushButton::clicked, this, &EngineSimulator::onFFOverSpeedClicked);
 
-    // 初始状态
-    ui->labelStartIndicator->setStyleSheet("background-color: gray;");
-    ui->labelRunIndicator->setStyleSheet("background-color: gray;");
+    // 数据日志和告警面板：固定容量的环形缓冲区，长时间运行内存不增长
+    dataLogModel = new LogListModel(DATA_LOG_ROWS, this);
+    alertLogModel = new LogListModel(ALERT_LOG_ROWS, this);
+    ui->dataLogDisplay->setModel(dataLogModel);
+    ui->alertLogDisplay->setModel(alertLogModel);
+
+    // 全部控件样式只设置一次，之后切换状态只修改动态属性
+    setStyleSheet(APP_STYLE_SHEET);
+    shownIndicator = 0;
 
 	// 仪表盘初始化
     n1LeftGauge = new GaugeWidget(GaugeWidget::N1, this);
@@ -66,350 +91,482 @@ EngineSimulator::EngineSimulator(QWidget* parent)
     egtRightGauge = new GaugeWidget(GaugeWidget::EGT, this);
     fuelLevelGauge = new GaugeWidget(GaugeWidget::FUEL_LEVEL, this);
 
+	// 跨度追踪中区分各仪表的重绘
+    n1LeftGauge->setTraceName("paintEvent N1 left");
+    n1RightGauge->setTraceName("paintEvent N1 right");
+    egtLeftGauge->setTraceName("paintEvent EGT left");
+    egtRightGauge->setTraceName("paintEvent EGT right");
+
 	// 将仪表盘添加到布局中
     ui->layoutN1Left->addWidget(n1LeftGauge);
     ui->layoutN1Right->addWidget(n1RightGauge);
     ui->layoutEGTLeft->addWidget(egtLeftGauge);
     ui->layoutEGTRight->addWidget(egtRightGauge);
     ui->layoutFuelLevel->addWidget(fuelLevelGauge);
+
+	// 注册样本消费者：仪表显示和日志记录各用一个缓冲区
+	Simulation& simulation = simulationThread->simulation();
+	simulation.addConsumer(&displayRing);
+	simulation.addConsumer(&logRing);
+
+	// 实时性统计：模拟线程记录唤醒延迟和生成/检测/发布耗时，日志线程记录写入耗时，界面线程记录刷新耗时
+	simulation.setStats(&tickStats);
+	simulationThread->setStats(&tickStats);
+	logger.setStats(&tickStats);
+
+	// 日志写入可执行文件所在目录下的 DataLogging/，告警显示到告警面板
+	// （回调在日志写入线程中调用，转交界面线程处理）
+	QString loggingDir = QCoreApplication::applicationDirPath() + "/DataLogging";
+	// 数据同时写 .csv 和 .tlm，.tlm 供回放使用；回放期间实时告警只写文件，不显示
+	logger.setLogDirectory(loggingDir.toLocal8Bit().toStdString());
+	logger.setDataLogFormat(DataLogFormat::Both);
+	logger.setAlertCallback([this](double, AlertLevel level, const std::string& text) {
+		QString message = QString::fromStdString(text);
+		QMetaObject::invokeMethod(this, [this, level, message]() {
+			if (!playbackMode) appendAlert(level, message);
+		}, Qt::QueuedConnection);
+	});
+
+	// 每次会话的种子和操作指令记录到 DataLogging/<时间>.jnl，可在批处理或界面中逐位重现
+	QDir().mkpath(loggingDir);
+	const QString sessionName = loggingDir + "/" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+	const QString journalPath = sessionName + ".jnl";
+	if (!simulationThread->recordTo(journalPath)) {
+		qWarning() << "Cannot write input journal:" << journalPath;
+	}
+	connect(simulationThread, &SimulationThread::replayFinished, this, [this](bool diverged) {
+		appendAlert(diverged ? AlertLevel::amberWarning : AlertLevel::normal,
+			diverged ? QStringLiteral("Replay diverged from the input journal") : QStringLiteral("Replay finished"));
+	}, Qt::QueuedConnection);
+
+	// 实时性统计面板（F12 显示/隐藏），统计同时定期写入 DataLogging/<时间>.stats
+	statsPath = sessionName + ".stats";
+	statsView = new QPlainTextEdit(this);
+	statsView->setReadOnly(true);
+	statsView->setLineWrapMode(QPlainTextEdit::NoWrap);
+	statsView->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+	statsDock = new QDockWidget(QStringLiteral("Timing"), this);
+	statsDock->setObjectName(QStringLiteral("statsDock"));
+	statsDock->setWidget(statsView);
+	addDockWidget(Qt::BottomDockWidgetArea, statsDock);
+	statsDock->hide();
+	QAction* toggleStats = statsDock->toggleViewAction();
+	toggleStats->setShortcut(Qt::Key_F12);
+	addAction(toggleStats);
+	statsTimer->setInterval(1000);
+	connect(statsTimer, &QTimer::timeout, this, &EngineSimulator::onStatsTimerTimeout);
+
+	// 跨度追踪（F11 开始/停止）
+	trace::setThreadName("ui");
+	traceDir = loggingDir;
+	QAction* toggleTrace = new QAction(QStringLiteral("Trace"), this);
+	toggleTrace->setShortcut(Qt::Key_F11);
+	connect(toggleTrace, &QAction::triggered, this, &EngineSimulator::toggleTracing);
+	addAction(toggleTrace);
+
+	// 日志回放控制条（Ctrl+O 打开 .tlm，Live 返回实时模拟）
+	QWidget* playbackBar = new QWidget(this);
+	QHBoxLayout* playbackLayout = new QHBoxLayout(playbackBar);
+	playButton = new QPushButton(QStringLiteral("Play"), playbackBar);
+	scrubBar = new QSlider(Qt::Horizontal, playbackBar);
+	speedBox = new QComboBox(playbackBar);
+	for (double speed : PLAYBACK_SPEEDS) {
+		speedBox->addItem(QString::number(speed) + "x", speed);
+	}
+	speedBox->setCurrentIndex(speedBox->findData(1.0));
+	playbackLabel = new QLabel(playbackBar);
+	playbackLabel->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+	QPushButton* liveButton = new QPushButton(QStringLiteral("Live"), playbackBar);
+	playbackLayout->addWidget(playButton);
+	playbackLayout->addWidget(scrubBar, 1);
+	playbackLayout->addWidget(playbackLabel);
+	playbackLayout->addWidget(speedBox);
+	playbackLayout->addWidget(liveButton);
+	playbackDock = new QDockWidget(QStringLiteral("Playback"), this);
+	playbackDock->setObjectName(QStringLiteral("playbackDock"));
+	playbackDock->setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
+	playbackDock->setWidget(playbackBar);
+	addDockWidget(Qt::BottomDockWidgetArea, playbackDock);
+	playbackDock->hide();
+	connect(playButton, &QPushButton::clicked, this, &EngineSimulator::onPlayPauseClicked);
+	connect(scrubBar, &QSlider::sliderMoved, this, &EngineSimulator::onScrubBarMoved);
+	connect(scrubBar, &QSlider::actionTriggered, this, &EngineSimulator::onScrubBarMoved);
+	connect(speedBox, &QComboBox::currentIndexChanged, this, &EngineSimulator::onPlaybackSpeedChanged);
+	connect(liveButton, &QPushButton::clicked, this, &EngineSimulator::closePlayback);
+	QAction* openLog = new QAction(QStringLiteral("Open log"), this);
+	openLog->setShortcut(QKeySequence::Open);
+	connect(openLog, &QAction::triggered, this, [this]() {
+		const QString path = QFileDialog::getOpenFileName(this, QStringLiteral("Open telemetry log"),
+			traceDir, QStringLiteral("Telemetry logs (*.tlm)"));
+		if (!path.isEmpty()) openPlayback(path);
+	});
+	addAction(openLog);
+
+	// 启动模拟线程、日志写入线程和界面刷新
+	simulationThread->start(QThread::HighestPriority);
+	logWriter.start();
+	refreshTimer->start();
+	statsTimer->start();
 }
 
 // 析构函数
 EngineSimulator::~EngineSimulator()
 {
+    // 先停止模拟线程，避免析构后仍向缓冲区写入
+    simulationThread->requestInterruption();
+    simulationThread->wait();
+    // 再停止日志写入线程，写完剩余样本
+    logWriter.stop();
+    // 最终统计和未停止的追踪
+    writeTickStats(statsPath.toLocal8Bit().toStdString(), tickStats);
+    if (tracingActive()) {
+        toggleTracing();
+    }
     delete ui;  // 释放内存
 }
 
+// 设置界面刷新率
+void EngineSimulator::setRefreshRate(int hz) {
+    hz = qBound(1, hz, 240);
+    refreshTimer->setInterval(1000 / hz);
+}
+
+// 回放输入日志
+bool EngineSimulator::replayJournal(const QString& path) {
+    Journal journal;
+    std::string error;
+    if (!loadJournal(path.toLocal8Bit().toStdString(), journal, error)) {
+        appendAlert(AlertLevel::amberWarning, QString::fromStdString(error));
+        return false;
+    }
+    simulationThread->replay(journal, &logRing);
+    return true;
+}
+
+// 开始/停止跨度追踪
+void EngineSimulator::toggleTracing() {
+    if (!tracingActive()) {
+        startTracing();
+        appendAlert(AlertLevel::normal, QStringLiteral("Tracing started, press F11 to stop"));
+        return;
+    }
+    const QString path = traceDir + "/" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss") + ".trace.json";
+    if (stopTracing(path.toLocal8Bit().toStdString())) {
+        appendAlert(AlertLevel::normal, QStringLiteral("Trace written to ") + path);
+    }
+    else {
+        appendAlert(AlertLevel::amberWarning, QStringLiteral("Cannot write trace: ") + path);
+    }
+}
+
+// 打开已记录的会话进入回放（已在回放时换成新文件）
+bool EngineSimulator::openPlayback(const QString& path) {
+    if (!playback.open(path.toLocal8Bit().toStdString())) {
+        appendAlert(AlertLevel::amberWarning, QStringLiteral("Cannot open telemetry log: ") + path);
+        return false;
+    }
+    playbackMode = true;
+    // 回放期间操作按钮只显示记录的状态，不向模拟线程投递指令
+    for (QPushButton* button : ui->centralWidget->findChildren<QPushButton*>()) {
+        button->setEnabled(false);
+    }
+    scrubBar->setRange(0, static_cast<int>(std::ceil((playback.endTime() - playback.startTime()) / SCRUB_UNIT)));
+    playbackDock->setWindowTitle(QStringLiteral("Playback - ") + QFileInfo(path).fileName());
+    playbackDock->show();
+    setPlaybackPlaying(false);
+    seekPlayback(playback.startTime());
+    return true;
+}
+
+// 退出回放：恢复按钮，告警面板从退出时刻起显示实时告警，仪表显示最新的实时样本
+void EngineSimulator::closePlayback() {
+    if (!playbackMode) return;
+    setPlaybackPlaying(false);
+    playbackMode = false;
+    playback.close();
+    playbackDock->hide();
+    for (QPushButton* button : ui->centralWidget->findChildren<QPushButton*>()) {
+        button->setEnabled(true);
+    }
+    alertLogModel->clear();
+    appendAlert(AlertLevel::normal, QStringLiteral("Playback closed"));
+    showSample(liveSample, true);
+}
+
+// 微基准：updateSensor 的样式切换开销
+double EngineSimulator::benchmarkUpdateSensor(int iterations) {
+    // 依次切换：全部正常、单传感器故障、左右双传感器故障、全部故障，每次调用都有按钮变换状态
+    AnomalyState states[4];
+    states[1].N1LS1Fail = states[1].EGTRS2Fail = true;
+    states[2].N1LS1Fail = states[2].N1LS2Fail = states[2].EGTRS1Fail = states[2].EGTRS2Fail = true;
+    states[2].FuelSFail = states[2].LowFuel = true;
+    states[3].N1LS1Fail = states[3].N1LS2Fail = states[3].N1RS1Fail = states[3].N1RS2Fail = true;
+    states[3].EGTLS1Fail = states[3].EGTLS2Fail = states[3].EGTRS1Fail = states[3].EGTRS2Fail = true;
+
+    const AnomalyState saved = anomalyState;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        anomalyState = states[i % 4];
+        updateSensor();
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    anomalyState = saved;
+    updateSensor();
+    return iterations > 0 ? elapsed / 1000.0 / iterations : 0.0;
+}
+
 // 启动按钮响应函数
 void EngineSimulator::onStartButtonClicked() {
-    if (!simulationTimer->isActive() && !(anomalyState.N1LS1Fail && anomalyState.N1LS2Fail && anomalyState.N1RS1Fail && anomalyState.N1RS2Fail) &&
-        !(anomalyState.EGTLS1Fail && anomalyState.EGTLS2Fail && anomalyState.EGTRS1Fail && anomalyState.EGTRS2Fail)) {
-        generator.startSequence();
-        TheGlobalTime = 0.0;
-        simulationTimer->start();
-        displayTimer->start();
-        logger.initLogFile();
-    }
+    applyCommand(Command::Start);
 }
 
 // 停车按钮响应函数 - 最高优先级
 void EngineSimulator::onStopButtonClicked() {
-    generator.stopSequence();
+    applyCommand(Command::Stop);
 }
 
 // 异常情况按钮响应函数
 void EngineSimulator::onN1LS1FailClicked() {
-    if (anomalyState.N1LS1Fail) {
-        anomalyState.N1LS1Fail = false;
-    }
-    else {
-        anomalyState.N1LS1Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::N1LS1Fail);
 }
 void EngineSimulator::onN1RS1FailClicked() {
-    if (anomalyState.N1RS1Fail) {
-        anomalyState.N1RS1Fail = false;
-    }
-    else {
-        anomalyState.N1RS1Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::N1RS1Fail);
 }
 void EngineSimulator::onN1LS2FailClicked() {
-    if (anomalyState.N1LS2Fail) {
-        anomalyState.N1LS2Fail = false;
-    }
-    else {
-        anomalyState.N1LS2Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::N1LS2Fail);
 }
 void EngineSimulator::onN1RS2FailClicked() {
-    if (anomalyState.N1RS2Fail) {
-        anomalyState.N1RS2Fail = false;
-    }
-    else {
-        anomalyState.N1RS2Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::N1RS2Fail);
 }
 void EngineSimulator::onEGTLS1FailClicked() {
-    if (anomalyState.EGTLS1Fail) {
-        anomalyState.EGTLS1Fail = false;
-    }
-    else {
-        anomalyState.EGTLS1Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::EGTLS1Fail);
 }
 void EngineSimulator::onEGTRS1FailClicked() {
-    if (anomalyState.EGTRS1Fail) {
-        anomalyState.EGTRS1Fail = false;
-    }
-    else {
-        anomalyState.EGTRS1Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::EGTRS1Fail);
 }
 void EngineSimulator::onEGTLS2FailClicked() {
-    if (anomalyState.EGTLS2Fail) {
-        anomalyState.EGTLS2Fail = false;
-    }
-    else {
-        anomalyState.EGTLS2Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::EGTLS2Fail);
 }
 void EngineSimulator::onEGTRS2FailClicked() {
-    if (anomalyState.EGTRS2Fail) {
-        anomalyState.EGTRS2Fail = false;
-    }
-    else {
-        anomalyState.EGTRS2Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::EGTRS2Fail);
 }
 void EngineSimulator::onN1SFailClicked() {
-    if (anomalyState.N1LS1Fail && anomalyState.N1LS2Fail
-        && anomalyState.N1RS1Fail && anomalyState.N1RS2Fail) {
-        anomalyState.N1LS1Fail = false;
-        anomalyState.N1RS1Fail = false;
-        anomalyState.N1LS2Fail = false;
-        anomalyState.N1RS2Fail = false;
-    }
-    else {
-        anomalyState.N1LS1Fail = true;
-        anomalyState.N1RS1Fail = true;
-        anomalyState.N1LS2Fail = true;
-        anomalyState.N1RS2Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::N1SFail);
 }
 void EngineSimulator::onEGTSFailClicked() {
-    if (anomalyState.EGTLS1Fail && anomalyState.EGTRS1Fail
-        && anomalyState.EGTLS2Fail && anomalyState.EGTRS2Fail) {
-        anomalyState.EGTLS1Fail = false;
-        anomalyState.EGTRS1Fail = false;
-        anomalyState.EGTLS2Fail = false;
-        anomalyState.EGTRS2Fail = false;
-    }
-    else {
-        anomalyState.EGTLS1Fail = true;
-        anomalyState.EGTRS1Fail = true;
-        anomalyState.EGTLS2Fail = true;
-        anomalyState.EGTRS2Fail = true;
-    }
-    updateSensor();
+    applyCommand(Command::EGTSFail);
 }
 void EngineSimulator::onFuelSFailClicked() {
-    if (anomalyState.FuelSFail) {
-        anomalyState.FuelSFail = false;
-    }
-    else {
-        anomalyState.FuelSFail = true;
-    }
-    updateSensor();
+    applyCommand(Command::FuelSFail);
 }
 
 // N1超转1
 void EngineSimulator::onN1OverSpeed1Clicked() {
-    if (currentData.phase != EnginePhase::Stopping && currentData.phase != EnginePhase::Idle) {
-        if (anomalyState.N1OverSpeedLevel == 1) {
-            anomalyState.N1OverSpeedLevel = 0;
-            currentData.n1LeftAverage = currentData.n1RightAverage = 100.0;
-            currentData.phase = EnginePhase::Stable;
-            generator.updateData(currentData);
-        }
-        else {
-            anomalyState.N1OverSpeedLevel = 1;
-            currentData.n1LeftAverage = currentData.n1RightAverage = 110.0;
-            currentData.phase = EnginePhase::Stable;
-            generator.updateData(currentData);
-        }
-    }
-    updateSpeed();
+    applyCommand(Command::N1OverSpeed1);
 }
 
 // N1超转2
 void EngineSimulator::onN1OverSpeed2Clicked() {
-    if (currentData.phase != EnginePhase::Stopping && currentData.phase != EnginePhase::Idle) {
-        if (anomalyState.N1OverSpeedLevel != 2) {
-            anomalyState.N1OverSpeedLevel = 2;
-            currentData.n1LeftAverage = currentData.n1RightAverage = 124.0;
-            generator.updateData(currentData);
-			onStopButtonClicked(); // 触发停车
-        }
-    }
-    updateSpeed();
-
+    applyCommand(Command::N1OverSpeed2);
 }
 
 // EGT超温1和2只能在启动阶段触发
 void EngineSimulator::onEGTOverSpeed1Clicked() {
-    if (currentData.phase == EnginePhase::Starting) {
-        if (anomalyState.EGTOverSpeedLevel == 1) {
-            anomalyState.EGTOverSpeedLevel = 0;
-            currentData.EGTOverSpeed1 = false;
-            generator.updateData(currentData);
-        }
-        else {
-            anomalyState.EGTOverSpeedLevel = 1;
-            currentData.EGTOverSpeed1 = true;
-            generator.updateData(currentData);
-        }
-    }
-    updateSpeed();
+    applyCommand(Command::EGTOverSpeed1);
 }
 void EngineSimulator::onEGTOverSpeed2Clicked() {
-    if (currentData.phase == EnginePhase::Starting) {
-        if (anomalyState.EGTOverSpeedLevel != 2) {
-            anomalyState.EGTOverSpeedLevel = 2;
-            currentData.egtLeftAverage = currentData.egtRightAverage = 1100.0;
-            generator.updateData(currentData);
-            onStopButtonClicked(); // 触发停车
-        }
-    }
-    updateSpeed();
+    applyCommand(Command::EGTOverSpeed2);
 }
 
 // EGT超温3和4只能在稳定阶段触发
 void EngineSimulator::onEGTOverSpeed3Clicked() {
-    if (currentData.phase == EnginePhase::Stable) {
-        if (anomalyState.EGTOverSpeedLevel == 3) {
-            anomalyState.EGTOverSpeedLevel = 0;
-            currentData.egtLeftAverage = currentData.egtRightAverage = 720.0;
-            generator.updateData(currentData);
-        }
-        else {
-            anomalyState.EGTOverSpeedLevel = 3;
-            currentData.egtLeftAverage = currentData.egtRightAverage = 1000.0;
-            generator.updateData(currentData);
-        }
-
-    }
-    updateSpeed();
+    applyCommand(Command::EGTOverSpeed3);
 }
 void EngineSimulator::onEGTOverSpeed4Clicked() {
-    if (currentData.phase == EnginePhase::Stable) {
-        if (anomalyState.EGTOverSpeedLevel != 4) {
-            anomalyState.EGTOverSpeedLevel = 4;
-            currentData.egtLeftAverage = currentData.egtRightAverage = 1170.0;
-            generator.updateData(currentData);
-            onStopButtonClicked();
-        }
-    }
-    updateSpeed();
+    applyCommand(Command::EGTOverSpeed4);
+}
+
+// 向模拟线程投递指令，界面在下一次快照中刷新
+void EngineSimulator::applyCommand(Command command) {
+    simulationThread->postCommand(command);
 }
 
-// 更新燃油流量显示
+// 更新燃油流量显示（文字或颜色变化时才设置控件）
 void EngineSimulator::updateFuelFlowDisplay() {
     // 动态设置颜色：>50 为琥珀色，否则为白色
-    if (currentData.fuelFlow > 50.0) {
-        ui->lcdFuelFlow->setText("Over Speed!");
-        ui->lcdFuelFlow->setStyleSheet(
-            "color: #FFBF00; "                      // 琥珀色
-            "font-family: \"Courier New\", monospace; "
-            "font-size: 24pt; "
-            "font-weight: bold; "
-            "background-color: black; "
-            "border: 1px solid #444; "
-            "padding: 5px; "
-            "text-align: center;"
-        );
-    }
-    else {
-        QString flowText = QString::number(currentData.fuelFlow, 'f', 1);
+    const int state = currentData.fuelFlow > 50.0 ? 1 : 0;
+    const QString flowText = state ? QString("Over Speed!") : QString::number(currentData.fuelFlow, 'f', 1);
+    if (flowText != shownFuelFlowText) {
         ui->lcdFuelFlow->setText(flowText);
-        ui->lcdFuelFlow->setStyleSheet(
-            "color: white; "
-            "font-family: \"Courier New\", monospace; "
-            "font-size: 24pt; "
-            "font-weight: bold; "
-            "background-color: black; "
-            "border: 1px solid #444; "
-            "padding: 5px; "
-            "text-align: center;"
-        );
+        shownFuelFlowText = flowText;
+    }
+    if (state != shownFuelFlowState) {
+        shownFuelFlowState = state;
+        setStyleState(ui->lcdFuelFlow, "overSpeed", state ? "true" : "false");
     }
 }
 
 // 低燃油状态切换
 void EngineSimulator::onLowFuelClicked() {
-    if (anomalyState.LowFuel) {
-        anomalyState.LowFuel = false;
-        currentData.fuelLevel += 19001.0; // 恢复正常燃油状态
-        generator.updateData(currentData);
-        fuelLevelGauge->updateValue(currentData.fuelLevel);
-    }
-    else {
-        anomalyState.LowFuel = true;
-        currentData.fuelLevel -= 19001.0; // 设置为低燃油状态
-        generator.updateData(currentData);
-        fuelLevelGauge->updateValue(currentData.fuelLevel);
-    }
-    updateSensor();
+    applyCommand(Command::LowFuel);
 }
 
 // 燃油流速超速切换
 void EngineSimulator::onFFOverSpeedClicked() {
-    if (currentData.phase == EnginePhase::Stable) {
-        if (anomalyState.FFOverSpeed) {
-            anomalyState.FFOverSpeed = false;
-            currentData.fuelFlow = 40.0;
-            generator.updateData(currentData);
-        }
-        else {
-            anomalyState.FFOverSpeed = true;
-            currentData.fuelFlow = 60.0; // 设置为高燃油流速状态
-            generator.updateData(currentData);
-        }
-    }
-    updateSpeed();
+    applyCommand(Command::FFOverSpeed);
 }
 
 // 增大推力
 void EngineSimulator::onIncreaseThrustClicked() {
-    if (currentData.phase == EnginePhase::Stable) {
-        generator.setIncreaseThrust(true);
-    }
+    applyCommand(Command::IncreaseThrust);
 }
 
 // 减小推力
 void EngineSimulator::onDecreaseThrustClicked() {
-    if (currentData.phase == EnginePhase::Stable) {
-        generator.setDecreaseThrust(true);
-    }
+    applyCommand(Command::DecreaseThrust);
 }
 
-// 5ms定时器触发函数
-void EngineSimulator::onSimulateTimerTimeout() {
-    // 全局时间更新
-	TheGlobalTime += 0.005; 
+// 界面刷新定时器触发函数
+void EngineSimulator::onRefreshTimerTimeout() {
+	// 仪表消费者：只取最新样本，没有新数据则跳过（回放期间照常取出，改为显示回放样本）
+    StageTimer timer(&tickStats);
+    TRACE_SPAN("refresh");
+    const bool received = displayRing.drain([this](const Sample& sample) { liveSample = sample; }) != 0;
+    if (playbackMode) {
+        advancePlayback();
+        return;
+    }
+    if (!received) {
+        return;
+    }
+    showSample(liveSample);
+    timer.lap(TickStage::Display);
+}
 
-	// 数据更新
-    generator.updateData();
-    currentData = generator.getData();
+// 显示一个样本
+void EngineSimulator::showSample(const Sample& sample, bool forceButtons) {
+    bool anomalyChanged = forceButtons || sample.anomaly != anomalyState;
+    currentData = sample.data;
+    anomalyState = sample.anomaly;
+    currentTime = sample.time;
 
-	// 检查数据异常
-    checkData();
+	// 异常状态变化时刷新按钮
+    if (anomalyChanged) {
+        updateSensor();
+        updateSpeed();
+    }
 
 	// UI显示更新
     updateDisplay();
 
-	// 日志记录与告警处理
-    logger.logDataAndAlerts(TheGlobalTime,generator.processData(currentData), anomalyState, ui->alertLogDisplay);
+	// 数据日志面板随运行状态启停
+    if (sample.running && !displayTimer->isActive()) {
+        displayTimer->start();
+    }
+    else if (!sample.running && displayTimer->isActive()) {
+        displayTimer->stop();
+    }
+}
+
+// 回放推进：回放时间按界面实际经过的时间乘以倍速前进，到末尾自动暂停
+void EngineSimulator::advancePlayback() {
+    if (!playbackPlaying) return;
+    TRACE_SPAN("playback");
+    playbackTime += static_cast<double>(playbackClock.restart()) * 1e-3 * playbackSpeed;
+    if (playbackTime >= playback.endTime()) {
+        playbackTime = playback.endTime();
+        setPlaybackPlaying(false);
+    }
+    Sample sample;
+    if (playback.sampleAt(playbackTime, sample)) {
+        sample.running = sample.running && playbackPlaying;
+        showSample(sample);
+    }
+    appendPlaybackAlerts();
+    updatePlaybackPosition();
+}
 
-	// 停车完成后停止定时器
-    if (currentData.phase == EnginePhase::Idle) {
-        initAnomalyState();
-        simulationTimer->stop();
+// 定位：样本和告警面板都只取决于目标时刻，与之前的回放位置无关
+void EngineSimulator::seekPlayback(double time) {
+    TRACE_SPAN("playbackSeek");
+    playbackTime = qBound(playback.startTime(), time, playback.endTime());
+    playbackClock.start();
+    Sample sample;
+    if (playback.sampleAt(playbackTime, sample)) {
+        sample.running = sample.running && playbackPlaying;
+        showSample(sample);
+    }
+    alertLogModel->clear();
+    playbackAlerts = 0;
+    appendPlaybackAlerts();
+    updatePlaybackPosition();
+}
+
+// 追加告警（面板只保留最近 ALERT_LOG_ROWS 条，更早的不再逐条追加）
+void EngineSimulator::appendPlaybackAlerts() {
+    const size_t count = playback.alertsUntil(playbackTime);
+    if (count > playbackAlerts + ALERT_LOG_ROWS) {
+        playbackAlerts = count - ALERT_LOG_ROWS;
+    }
+    for (; playbackAlerts < count; ++playbackAlerts) {
+        const PlaybackAlert& alert = playback.alerts()[playbackAlerts];
+        appendAlert(alert.level, QString::fromStdString(alert.text));
+    }
+}
+
+void EngineSimulator::setPlaybackPlaying(bool playing) {
+    playbackPlaying = playing;
+    playButton->setText(playing ? QStringLiteral("Pause") : QStringLiteral("Play"));
+    if (playing) {
+        playbackClock.start();
+    }
+    else if (displayTimer->isActive()) {
         displayTimer->stop();
     }
 }
 
+// 拖动进度条时不改写滑块位置
+void EngineSimulator::updatePlaybackPosition() {
+    if (!scrubBar->isSliderDown()) {
+        scrubBar->setValue(static_cast<int>((playbackTime - playback.startTime()) / SCRUB_UNIT + 0.5));
+    }
+    playbackLabel->setText(QString("%1 / %2 s")
+        .arg(playbackTime, 0, 'f', 2)
+        .arg(playback.endTime(), 0, 'f', 2));
+}
+
+// 播放/暂停；已到末尾时从头播放
+void EngineSimulator::onPlayPauseClicked() {
+    if (!playbackPlaying && playbackTime >= playback.endTime()) {
+        seekPlayback(playback.startTime());
+    }
+    setPlaybackPlaying(!playbackPlaying);
+}
+
+// 拖动或点击进度条：sliderPosition 已是目标位置
+void EngineSimulator::onScrubBarMoved() {
+    seekPlayback(playback.startTime() + scrubBar->sliderPosition() * SCRUB_UNIT);
+}
+
+void EngineSimulator::onPlaybackSpeedChanged(int index) {
+    playbackSpeed = speedBox->itemData(index).toDouble();
+}
+
+// 实时性统计定时器触发函数
+void EngineSimulator::onStatsTimerTimeout() {
+    if (statsDock->isVisible()) {
+        statsView->setPlainText(QString::fromStdString(formatTickStats(tickStats)));
+    }
+    if (++statsSeconds % STATS_DUMP_SECONDS == 0
+        && !writeTickStats(statsPath.toLocal8Bit().toStdString(), tickStats)) {
+        qWarning() << "Cannot write tick statistics:" << statsPath;
+    }
+}
+
 // 1秒定时器触发函数
 void EngineSimulator::onDisplayTimerTimeout() {
+    TRACE_SPAN("dataLogPanel");
     // 定义各数据字段的有效性判断函数（内联函数，简洁易维护）
 	bool isValidN1L = !(anomalyState.N1LS1Fail && anomalyState.N1LS2Fail); // N1是百分比，0-120
 	bool isValidN1R = !(anomalyState.N1RS1Fail && anomalyState.N1RS2Fail); // N1是百分比，0-120
@@ -419,10 +576,10 @@ void EngineSimulator::onDisplayTimerTimeout() {
 	bool isValidFuelFlow = !anomalyState.FFOverSpeed; // 燃油流速超速
 
 	// 处理数据以获取UI显示值
-	SensorData uiData = generator.processData(currentData);
+	SensorData uiData = DataGenerator::processData(currentData);
 
     // 逐个字段处理：有效则格式化数值，无效则显示N/A
-    QString timeStr = QString::number(TheGlobalTime, 'f', 2);
+    QString timeStr = QString::number(currentTime, 'f', 2);
     QString n1LeftStr = isValidN1L ? QString::number(uiData.n1LeftAverage, 'f', 2) : "N/A"; 
     QString n1RightStr = isValidN1R ? QString::number(uiData.n1RightAverage, 'f', 2) : "N/A";
     QString egtLeftStr = isValidEGTL ? QString::number(uiData.egtLeftAverage, 'f', 1) : "N/A";
@@ -442,26 +599,22 @@ void EngineSimulator::onDisplayTimerTimeout() {
         .arg(fuelFlowStr)
         .arg(phaseStr);
 
-    ui->dataLogDisplay->append(log);
+    dataLogModel->append(log);
 }
 
 // UI显示更新函数
 void EngineSimulator::updateDisplay() {
-	// 更新启动和运行指示灯
-    if (currentData.phase == EnginePhase::Starting) {
-        ui->labelStartIndicator->setStyleSheet("background-color: green;");
-        ui->labelRunIndicator->setStyleSheet("background-color: gray;");
-    }
-    else if (currentData.phase == EnginePhase::Stable) {
-        ui->labelStartIndicator->setStyleSheet("background-color: gray;");
-        ui->labelRunIndicator->setStyleSheet("background-color: green;");
-    }
-    else {
-        ui->labelStartIndicator->setStyleSheet("background-color: gray;");
-        ui->labelRunIndicator->setStyleSheet("background-color: gray;");
+    TRACE_SPAN("updateDisplay");
+	// 更新启动和运行指示灯（阶段变化时才设置样式）
+    const int indicator = currentData.phase == EnginePhase::Starting ? 1
+        : currentData.phase == EnginePhase::Stable ? 2 : 0;
+    if (indicator != shownIndicator) {
+        shownIndicator = indicator;
+        setStyleState(ui->labelStartIndicator, "lit", indicator == 1 ? "true" : "false");
+        setStyleState(ui->labelRunIndicator, "lit", indicator == 2 ? "true" : "false");
     }
 
-    // 更新仪表数字显示
+    // 更新仪表数字显示（仪表自身判断是否需要重绘）
     n1LeftGauge->updateValue(currentData.n1LeftAverage);
     n1RightGauge->updateValue(currentData.n1RightAverage);
     egtLeftGauge->updateValue(currentData.egtLeftAverage);
@@ -473,201 +626,100 @@ void EngineSimulator::updateDisplay() {
 
 }
 
-// 数据异常检查函数
-void EngineSimulator::checkData() {
-    bool updateSensorFlag = false;
-    bool updateSpeedFlag = false;
-
-    // N1 超转检测
-    if ((currentData.n1LeftAverage > 120.0 || currentData.n1RightAverage > 120.0)
-        && anomalyState.N1OverSpeedLevel != 2) {
-        anomalyState.N1OverSpeedLevel = 2;
-        updateSpeedFlag = true;
-        onStopButtonClicked();
-    }
-    else if ((currentData.n1LeftAverage > 105.0 || currentData.n1RightAverage > 105.0)
-        && anomalyState.N1OverSpeedLevel != 1) {
-        if (anomalyState.N1OverSpeedLevel == 0) { // 避免重复触发
-        }
-        anomalyState.N1OverSpeedLevel = 1;
-        updateSpeedFlag = true;
-    }
-    else if ((currentData.n1LeftAverage <= 105.0 && currentData.n1RightAverage <= 105.0)
-        && anomalyState.N1OverSpeedLevel != 0) {
-        anomalyState.N1OverSpeedLevel = 0;
-        updateSpeedFlag = true;
-    }
-
-    // EGT 超温检测
-    bool inStarting = (currentData.phase == EnginePhase::Starting) ||
-        (currentData.lastPhase == EnginePhase::Starting && currentData.phase == EnginePhase::Stopping);
-    bool inStable = (currentData.phase == EnginePhase::Stable) ||
-        (currentData.lastPhase == EnginePhase::Stable && currentData.phase == EnginePhase::Stopping);
-
-    if (inStarting) {
-        if ((currentData.egtLeftAverage > 1000.0 || currentData.egtRightAverage > 1000.0)
-            && anomalyState.EGTOverSpeedLevel != 2) {
-            anomalyState.EGTOverSpeedLevel = 2;
-            generator.updateData(currentData);
-            updateSpeedFlag = true;
-            onStopButtonClicked();
-        }
-        else if ((currentData.egtLeftAverage > 850.0 || currentData.egtRightAverage > 850.0)
-            && anomalyState.EGTOverSpeedLevel != 1) {
-            if (anomalyState.EGTOverSpeedLevel == 0) {
-            }
-            anomalyState.EGTOverSpeedLevel = 1;
-            updateSpeedFlag = true;
-        }
-        else if ((currentData.egtLeftAverage <= 850.0 && currentData.egtRightAverage <= 850.0)
-            && anomalyState.EGTOverSpeedLevel != 0) {
-            anomalyState.EGTOverSpeedLevel = 0;
-            updateSpeedFlag = true;
-        }
-    }
-    else if (inStable) {
-        if ((currentData.egtLeftAverage > 1100.0 || currentData.egtRightAverage > 1100.0)
-            && anomalyState.EGTOverSpeedLevel != 4) {
-            anomalyState.EGTOverSpeedLevel = 4;
-            generator.updateData(currentData);
-            updateSpeedFlag = true;
-            onStopButtonClicked();
-        }
-        else if ((currentData.egtLeftAverage > 950.0 || currentData.egtRightAverage > 950.0)
-            && anomalyState.EGTOverSpeedLevel != 3) {
-            if (anomalyState.EGTOverSpeedLevel == 0) {
-            }
-            anomalyState.EGTOverSpeedLevel = 3;
-            updateSpeedFlag = true;
-        }
-        else if ((currentData.egtLeftAverage <= 950.0 && currentData.egtRightAverage <= 950.0)
-            && anomalyState.EGTOverSpeedLevel != 0) {
-            anomalyState.EGTOverSpeedLevel = 0;
-            updateSpeedFlag = true;
-        }
-    }
-
-    // 燃油流速超限检测
-    if (currentData.fuelFlow > 50.0 && !anomalyState.FFOverSpeed) {
-        anomalyState.FFOverSpeed = true;
-        updateSpeedFlag = true;
-    }
-    else if (currentData.fuelFlow <= 50.0 && anomalyState.FFOverSpeed) {
-        anomalyState.FFOverSpeed = false;
-        updateSpeedFlag = true;
-    }
-
-    // 燃油余量过低检测
-    if (currentData.fuelLevel < 1000.0 && !anomalyState.LowFuel) {
-        anomalyState.LowFuel = true;
-        updateSensorFlag = true;
-    }
-    else if (currentData.fuelLevel >= 1000.0 && anomalyState.LowFuel) {
-        anomalyState.LowFuel = false;
-        updateSensorFlag = true;
-    }
-
-	// 注意：燃油流速检测被集成在了 updateFuelFlowDisplay() 中
-
-    // 更新 UI
-    if (updateSensorFlag) updateSensor();
-    if (updateSpeedFlag) updateSpeed();
+// 在告警面板追加一条带颜色的告警
+void EngineSimulator::appendAlert(AlertLevel level, const QString& text) {
+    alertLogModel->append(text, level);
 }
 
 // 传感器故障状态更新函数
 void EngineSimulator::updateSensor() {
+    TRACE_SPAN("updateSensor");
     // 处理 N1 系列按钮
     // 判断 N1 总故障
     if (anomalyState.N1LS1Fail && anomalyState.N1LS2Fail &&
         anomalyState.N1RS1Fail && anomalyState.N1RS2Fail) {
         // N1 总故障按钮 + 4个传感器按钮 全红
         ui->N1SFail->setChecked(true);
-        ui->N1SFail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->N1SFail, BTN_STATE_RED);
 
         ui->N1LS1Fail->setChecked(true);
-        ui->N1LS1Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->N1LS1Fail, BTN_STATE_RED);
 
         ui->N1LS2Fail->setChecked(true);
-        ui->N1LS2Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->N1LS2Fail, BTN_STATE_RED);
 
         ui->N1RS1Fail->setChecked(true);
-        ui->N1RS1Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->N1RS1Fail, BTN_STATE_RED);
 
         ui->N1RS2Fail->setChecked(true);
-        ui->N1RS2Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->N1RS2Fail, BTN_STATE_RED);
 
-        // N1 左右仪表设为红色报警
+        // N1 左右仪表设为红色报警（红色警告的停车由模拟核心处理）
         n1LeftGauge->updateLevel(AlertLevel::redWarning);
         n1RightGauge->updateLevel(AlertLevel::redWarning);
-
-        // 红色警告直接停车
-        onStopButtonClicked();
-
-        // 记录日志并显示警报
-        onStopButtonClicked();
     }
     else {
         // 分别处理左/右传感器
         ui->N1SFail->setChecked(false);
-        ui->N1SFail->setStyleSheet(NORMAL_BTN_STYLE);
+        setButtonState(ui->N1SFail, BTN_STATE_NORMAL);
 
         // 处理左 N1 传感器（N1LS1/N1LS2）
         if (anomalyState.N1LS1Fail && anomalyState.N1LS2Fail) {
             ui->N1LS1Fail->setChecked(true);
-            ui->N1LS1Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->N1LS1Fail, BTN_STATE_AMBER);
             ui->N1LS2Fail->setChecked(true);
-            ui->N1LS2Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->N1LS2Fail, BTN_STATE_AMBER);
             n1LeftGauge->updateLevel(AlertLevel::amberWarning);
         }
         else if (anomalyState.N1LS1Fail) {
             ui->N1LS1Fail->setChecked(true);
-            ui->N1LS1Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->N1LS1Fail, BTN_STATE_WHITE);
             ui->N1LS2Fail->setChecked(false);
-            ui->N1LS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1LS2Fail, BTN_STATE_NORMAL);
             n1LeftGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else if (anomalyState.N1LS2Fail) {
             ui->N1LS2Fail->setChecked(true);
-            ui->N1LS2Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->N1LS2Fail, BTN_STATE_WHITE);
             ui->N1LS1Fail->setChecked(false);
-            ui->N1LS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1LS1Fail, BTN_STATE_NORMAL);
             n1LeftGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else {
             ui->N1LS1Fail->setChecked(false);
-            ui->N1LS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1LS1Fail, BTN_STATE_NORMAL);
             ui->N1LS2Fail->setChecked(false);
-            ui->N1LS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1LS2Fail, BTN_STATE_NORMAL);
             n1LeftGauge->updateLevel(AlertLevel::normal);
         }
 
         // 处理右 N1 传感器（N1RS1/N1RS2）
         if (anomalyState.N1RS1Fail && anomalyState.N1RS2Fail) {
             ui->N1RS1Fail->setChecked(true);
-            ui->N1RS1Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->N1RS1Fail, BTN_STATE_AMBER);
             ui->N1RS2Fail->setChecked(true);
-            ui->N1RS2Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->N1RS2Fail, BTN_STATE_AMBER);
             n1RightGauge->updateLevel(AlertLevel::amberWarning);
         }
         else if (anomalyState.N1RS1Fail) {
             ui->N1RS1Fail->setChecked(true);
-            ui->N1RS1Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->N1RS1Fail, BTN_STATE_WHITE);
             ui->N1RS2Fail->setChecked(false);
-            ui->N1RS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1RS2Fail, BTN_STATE_NORMAL);
             n1RightGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else if (anomalyState.N1RS2Fail) {
             ui->N1RS2Fail->setChecked(true);
-            ui->N1RS2Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->N1RS2Fail, BTN_STATE_WHITE);
             ui->N1RS1Fail->setChecked(false);
-            ui->N1RS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1RS1Fail, BTN_STATE_NORMAL);
             n1RightGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else {
             ui->N1RS1Fail->setChecked(false);
-            ui->N1RS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1RS1Fail, BTN_STATE_NORMAL);
             ui->N1RS2Fail->setChecked(false);
-            ui->N1RS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->N1RS2Fail, BTN_STATE_NORMAL);
             n1RightGauge->updateLevel(AlertLevel::normal);
         }
     }
@@ -677,85 +729,79 @@ void EngineSimulator::updateSensor() {
         anomalyState.EGTRS1Fail && anomalyState.EGTRS2Fail) {
         // EGT 总故障按钮 + 4个传感器按钮 全红
         ui->EGTSFail->setChecked(true);
-        ui->EGTSFail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->EGTSFail, BTN_STATE_RED);
         ui->EGTLS1Fail->setChecked(true);
-        ui->EGTLS1Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->EGTLS1Fail, BTN_STATE_RED);
         ui->EGTLS2Fail->setChecked(true);
-        ui->EGTLS2Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->EGTLS2Fail, BTN_STATE_RED);
         ui->EGTRS1Fail->setChecked(true);
-        ui->EGTRS1Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->EGTRS1Fail, BTN_STATE_RED);
         ui->EGTRS2Fail->setChecked(true);
-        ui->EGTRS2Fail->setStyleSheet(CHECKED_BTN_STYLE_RED);
-        // EGT 左右仪表设为红色报警
+        setButtonState(ui->EGTRS2Fail, BTN_STATE_RED);
+        // EGT 左右仪表设为红色报警（红色警告的停车由模拟核心处理）
         egtLeftGauge->updateLevel(AlertLevel::redWarning);
         egtRightGauge->updateLevel(AlertLevel::redWarning);
-
-        // 红色警告直接停车
-        onStopButtonClicked();
-
-        // 记录日志并显示警报
-        onStopButtonClicked();
     }
     else {
         // 分别处理左/右传感器
         ui->EGTSFail->setChecked(false);
-        ui->EGTSFail->setStyleSheet(NORMAL_BTN_STYLE);
+        setButtonState(ui->EGTSFail, BTN_STATE_NORMAL);
         // 处理左 EGT 传感器（EGTLS1/EGTLS2）
         if (anomalyState.EGTLS1Fail && anomalyState.EGTLS2Fail) {
             ui->EGTLS1Fail->setChecked(true);
-            ui->EGTLS1Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->EGTLS1Fail, BTN_STATE_AMBER);
             ui->EGTLS2Fail->setChecked(true);
-            ui->EGTLS2Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->EGTLS2Fail, BTN_STATE_AMBER);
             egtLeftGauge->updateLevel(AlertLevel::amberWarning);
         }
         else if (anomalyState.EGTLS1Fail) {
             ui->EGTLS1Fail->setChecked(true);
-            ui->EGTLS1Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->EGTLS1Fail, BTN_STATE_WHITE);
             ui->EGTLS2Fail->setChecked(false);
-            ui->EGTLS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTLS2Fail, BTN_STATE_NORMAL);
             egtLeftGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else if (anomalyState.EGTLS2Fail) {
             ui->EGTLS2Fail->setChecked(true);
-            ui->EGTLS2Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->EGTLS2Fail, BTN_STATE_WHITE);
             ui->EGTLS1Fail->setChecked(false);
-            ui->EGTLS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTLS1Fail, BTN_STATE_NORMAL);
             egtLeftGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else {
             ui->EGTLS1Fail->setChecked(false);
-            ui->EGTLS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTLS1Fail, BTN_STATE_NORMAL);
             ui->EGTLS2Fail->setChecked(false);
-            ui->EGTLS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTLS2Fail, BTN_STATE_NORMAL);
             egtLeftGauge->updateLevel(AlertLevel::normal);
         }
         // 处理右 EGT 传感器（EGTRS1/EGTRS2）
         if (anomalyState.EGTRS1Fail && anomalyState.EGTRS2Fail) {
             ui->EGTRS1Fail->setChecked(true);
-            ui->EGTRS1Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->EGTRS1Fail, BTN_STATE_AMBER);
             ui->EGTRS2Fail->setChecked(true);
-            ui->EGTRS2Fail->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+            setButtonState(ui->EGTRS2Fail, BTN_STATE_AMBER);
             egtRightGauge->updateLevel(AlertLevel::amberWarning);
         }
         else if (anomalyState.EGTRS1Fail) {
             ui->EGTRS1Fail->setChecked(true);
-            ui->EGTRS1Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->EGTRS1Fail, BTN_STATE_WHITE);
             ui->EGTRS2Fail->setChecked(false);
-            ui->EGTRS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTRS2Fail, BTN_STATE_NORMAL);
             egtRightGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else if (anomalyState.EGTRS2Fail) {
             ui->EGTRS2Fail->setChecked(true);
-            ui->EGTRS2Fail->setStyleSheet(CHECKED_BTN_STYLE_WHITE);
+            setButtonState(ui->EGTRS2Fail, BTN_STATE_WHITE);
             ui->EGTRS1Fail->setChecked(false);
-            ui->EGTRS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTRS1Fail, BTN_STATE_NORMAL);
             egtRightGauge->updateLevel(AlertLevel::whiteWarning);
         }
         else {
             ui->EGTRS1Fail->setChecked(false);
-            ui->EGTRS1Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTRS1Fail, BTN_STATE_NORMAL);
             ui->EGTRS2Fail->setChecked(false);
-            ui->EGTRS2Fail->setStyleSheet(NORMAL_BTN_STYLE);
+            setButtonState(ui->EGTRS2Fail, BTN_STATE_NORMAL);
             egtRightGauge->updateLevel(AlertLevel::normal);
         }
     }
@@ -763,104 +809,67 @@ void EngineSimulator::updateSensor() {
     // 处理燃油余量传感器按钮
     if (anomalyState.FuelSFail) {
         ui->FuelSFail->setChecked(true);
-        ui->FuelSFail->setStyleSheet(CHECKED_BTN_STYLE_RED);
+        setButtonState(ui->FuelSFail, BTN_STATE_RED);
         fuelLevelGauge->updateLevel(AlertLevel::redWarning);
     }
     else {
         ui->FuelSFail->setChecked(false);
-        ui->FuelSFail->setStyleSheet(NORMAL_BTN_STYLE);
+        setButtonState(ui->FuelSFail, BTN_STATE_NORMAL);
         fuelLevelGauge->updateLevel(AlertLevel::normal);
     }
 
     // 处理低燃油按钮
     if (anomalyState.LowFuel) {
         ui->LowFuel->setChecked(true);
-        ui->LowFuel->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
+        setButtonState(ui->LowFuel, BTN_STATE_AMBER);
     }
     else {
         ui->LowFuel->setChecked(false);
-        ui->LowFuel->setStyleSheet(NORMAL_BTN_STYLE);
+        setButtonState(ui->LowFuel, BTN_STATE_NORMAL);
     }
 }
 
-// 重置超速状态
+// 重置超速状态（停车复位时使用；刷新显示用 updateSpeed()，每个按钮直接切换到最终状态）
 void EngineSimulator::resetSpeed() {
     ui->N1OverSpeed1->setChecked(false);
-    ui->N1OverSpeed1->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->N1OverSpeed1, BTN_STATE_NORMAL);
     ui->N1OverSpeed2->setChecked(false);
-    ui->N1OverSpeed2->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->N1OverSpeed2, BTN_STATE_NORMAL);
     ui->EGTOverSpeed1->setChecked(false);
-    ui->EGTOverSpeed1->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->EGTOverSpeed1, BTN_STATE_NORMAL);
     ui->EGTOverSpeed2->setChecked(false);
-    ui->EGTOverSpeed2->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->EGTOverSpeed2, BTN_STATE_NORMAL);
     ui->EGTOverSpeed3->setChecked(false);
-    ui->EGTOverSpeed3->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->EGTOverSpeed3, BTN_STATE_NORMAL);
     ui->EGTOverSpeed4->setChecked(false);
-    ui->EGTOverSpeed4->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->EGTOverSpeed4, BTN_STATE_NORMAL);
     ui->FFOverSpeed->setChecked(false);
-    ui->FFOverSpeed->setStyleSheet(NORMAL_BTN_STYLE);
+    setButtonState(ui->FFOverSpeed, BTN_STATE_NORMAL);
 }
 
-// 更新超速状态显示
+// 更新超速状态显示：由异常等级直接求出每个按钮的最终状态，每个按钮只切换一次，
+// 状态不变的按钮不会重新 polish（低燃油按钮由 updateSensor() 处理）
 void EngineSimulator::updateSpeed() {
-	// 先重置超速状态
-    resetSpeed();
-    // 更新 N1 超速按钮
-    switch (anomalyState.N1OverSpeedLevel) {
-    case 0:
-        break;
-    case 1:
-        ui->N1OverSpeed1->setChecked(true);
-        ui->N1OverSpeed1->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
-        break;
-
-    case 2:
-        ui->N1OverSpeed2->setChecked(true);
-        ui->N1OverSpeed2->setStyleSheet(CHECKED_BTN_STYLE_RED);
-        break;
-    }
-
-	// 更新 EGT 超温按钮
-    switch (anomalyState.EGTOverSpeedLevel) {
-    case 0:
-        break;
-    case 1:
-        ui->EGTOverSpeed1->setChecked(true);
-        ui->EGTOverSpeed1->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
-        break;
-    case 2:
-        ui->EGTOverSpeed2->setChecked(true);
-        ui->EGTOverSpeed2->setStyleSheet(CHECKED_BTN_STYLE_RED);
-        break;
-    case 3:
-        ui->EGTOverSpeed3->setChecked(true);
-        ui->EGTOverSpeed3->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
-        break;
-    case 4:
-        ui->EGTOverSpeed4->setChecked(true);
-        ui->EGTOverSpeed4->setStyleSheet(CHECKED_BTN_STYLE_RED);
-        break;
-    }
-
-	// 更新低油显示按钮
-    if (anomalyState.LowFuel) {
-        ui->LowFuel->setChecked(true);
-        ui->LowFuel->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
-    }
-
-	// 更新燃油流速超速按钮
-    if (anomalyState.FFOverSpeed) {
-        ui->FFOverSpeed->setChecked(true);
-        ui->FFOverSpeed->setStyleSheet(CHECKED_BTN_STYLE_AMBER);
-    }
-}
-
-// 初始化异常状态
-// 注意：这里不会重置传感器故障状态，因为停车后传感器故障并不会消失
-void EngineSimulator::initAnomalyState() {
-    resetSpeed();
-    anomalyState.EGTOverSpeedLevel = 0;
-    anomalyState.N1OverSpeedLevel = 0;
-    anomalyState.FFOverSpeed = false;
-}
-
+    TRACE_SPAN("updateSpeed");
+    // N1 超速按钮：1 级琥珀色，2 级红色
+    const int n1Level = anomalyState.N1OverSpeedLevel;
+    ui->N1OverSpeed1->setChecked(n1Level == 1);
+    setButtonState(ui->N1OverSpeed1, n1Level == 1 ? BTN_STATE_AMBER : BTN_STATE_NORMAL);
+    ui->N1OverSpeed2->setChecked(n1Level == 2);
+    setButtonState(ui->N1OverSpeed2, n1Level == 2 ? BTN_STATE_RED : BTN_STATE_NORMAL);
+
+    // EGT 超温按钮：1、3 级琥珀色，2、4 级红色
+    const int egtLevel = anomalyState.EGTOverSpeedLevel;
+    ui->EGTOverSpeed1->setChecked(egtLevel == 1);
+    setButtonState(ui->EGTOverSpeed1, egtLevel == 1 ? BTN_STATE_AMBER : BTN_STATE_NORMAL);
+    ui->EGTOverSpeed2->setChecked(egtLevel == 2);
+    setButtonState(ui->EGTOverSpeed2, egtLevel == 2 ? BTN_STATE_RED : BTN_STATE_NORMAL);
+    ui->EGTOverSpeed3->setChecked(egtLevel == 3);
+    setButtonState(ui->EGTOverSpeed3, egtLevel == 3 ? BTN_STATE_AMBER : BTN_STATE_NORMAL);
+    ui->EGTOverSpeed4->setChecked(egtLevel == 4);
+    setButtonState(ui->EGTOverSpeed4, egtLevel == 4 ? BTN_STATE_RED : BTN_STATE_NORMAL);
+
+    // 燃油流速超速按钮
+    ui->FFOverSpeed->setChecked(anomalyState.FFOverSpeed);
+    setButtonState(ui->FFOverSpeed, anomalyState.FFOverSpeed ? BTN_STATE_AMBER : BTN_STATE_NORMAL);
+}
\ No newline at end of file
@@ -3,11 +3,24 @@
 
 #include <QtWidgets/QMainWindow>
 #include "ui_EngineSimulator.h"
-#include "DataGenerator.h"
+#include "Simulation.h"
+#include "SimulationThread.h"
+#include "SampleRing.h"
 #include "Logger.h"
+#include "AsyncLogWriter.h"
 #include "EngineState.h"
 #include "GaugeWidget.h"
+#include "LogListModel.h"
+#include "TickStats.h"
+#include "LogPlayback.h"
 #include <QTimer>
+#include <QDockWidget>
+#include <QPlainTextEdit>
+#include <QElapsedTimer>
+#include <QPushButton>
+#include <QSlider>
+#include <QComboBox>
+#include <QLabel>
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class EngineSimulatorClass; }
@@ -22,6 +35,24 @@ public:
     explicit EngineSimulator(QWidget* parent = nullptr);
     ~EngineSimulator();
 
+	// 设置界面刷新率（Hz），与模拟步长无关
+	void setRefreshRate(int hz);
+
+	// 微基准：在几组异常状态之间轮换调用 updateSensor，返回平均每次耗时（微秒）
+	double benchmarkUpdateSensor(int iterations);
+
+	// 回放输入日志（.jnl），结束当前会话的记录；读取失败返回 false
+	bool replayJournal(const QString& path);
+
+	// 开始/停止跨度追踪（F11），停止时写出 DataLogging/<时间>.trace.json
+	void toggleTracing();
+
+	// 打开已记录的会话（.tlm，Ctrl+O）进入回放，仪表和告警面板改由日志文件驱动；打开失败返回 false
+	bool openPlayback(const QString& path);
+
+	// 退出回放，恢复显示实时模拟
+	void closePlayback();
+
 
 // 在Qt中，加slots关键字表示该函数是一个槽函数，可以响应信号
 private slots:
@@ -30,18 +61,23 @@ private slots:
     void onStopButtonClicked();
 
 
-    // 5ms定时器触发
-    void onSimulateTimerTimeout(); 
+    // 界面刷新定时器触发，读取模拟线程发布的样本
+    void onRefreshTimerTimeout();
 
 	// 1秒定时器触发，用于更新UI显示
 	void onDisplayTimerTimeout();
 
+	// 1秒定时器触发，刷新实时性统计面板并定期写入 DataLogging
+	void onStatsTimerTimeout();
+
+	// 回放控制：播放/暂停、拖动进度条、切换倍速
+	void onPlayPauseClicked();
+	void onScrubBarMoved();
+	void onPlaybackSpeedChanged(int index);
+
 	// UI显示更新函数
     void updateDisplay();
 
-	// 检查传入数据函数
-	void checkData();
-
 	// 推力控制按钮响应槽函数
     void onIncreaseThrustClicked();
     void onDecreaseThrustClicked();
@@ -77,30 +113,85 @@ private slots:
 	void updateFuelFlowDisplay();
 	void onLowFuelClicked();
 
-	// 初始化异常按钮状态
-	void initAnomalyState();
-	
 
 private:
+	// 向模拟线程投递操作指令
+	void applyCommand(Command command);
+
+	// 在告警面板追加一条带颜色的告警
+	void appendAlert(AlertLevel level, const QString& text);
+
+	// 显示一个样本（实时或回放）；forceButtons 为 true 时即使异常状态未变也刷新按钮
+	void showSample(const Sample& sample, bool forceButtons = false);
+
+	// 回放：按经过的时间和倍速推进；定位到任意时刻并重建告警面板
+	void advancePlayback();
+	void seekPlayback(double time);
+	void setPlaybackPlaying(bool playing);
+	// 追加回放时间之前尚未显示的告警
+	void appendPlaybackAlerts();
+	// 同步进度条和时间标签
+	void updatePlaybackPosition();
+
 	// --- 成员变量 ---
     Ui::EngineSimulatorClass* ui;
 
-	// 全局时间
-	double TheGlobalTime;
-	// 用于在后台模拟数据生成，5ms更新一次
-    QTimer* simulationTimer;
+	// 用于读取模拟快照刷新仪表，按显示刷新率触发（默认 60Hz）
+    QTimer* refreshTimer;
 	// 用于在UI显示，1秒更新一次更合理
 	QTimer* displayTimer;
 
-	// 数据生成器
-    DataGenerator generator;
-
-	// 日志记录器
+	// 模拟线程（数据生成、异常检测在其中以 5ms 固定步长进行）
+    SimulationThread* simulationThread;
+
+	// 实时性统计：唤醒延迟、各阶段耗时和超时步数（模拟线程、日志线程、界面线程各写各的直方图）
+	TickStats tickStats;
+	static constexpr int STATS_DUMP_SECONDS = 10;
+	QTimer* statsTimer;
+	QDockWidget* statsDock;
+	QPlainTextEdit* statsView;
+	QString statsPath;
+	int statsSeconds;
+
+	// 跨度追踪文件目录
+	QString traceDir;
+
+	// 日志回放（回放期间界面不显示实时模拟，模拟线程照常运行）
+	static constexpr double SCRUB_UNIT = 0.01;   // 进度条刻度（秒）
+	LogPlayback playback;
+	bool playbackMode;
+	bool playbackPlaying;
+	double playbackTime;
+	double playbackSpeed;
+	size_t playbackAlerts;       // 告警面板已显示到的告警序号
+	QElapsedTimer playbackClock;
+	Sample liveSample;           // 最新的实时样本，退出回放时恢复显示
+	QDockWidget* playbackDock;
+	QPushButton* playButton;
+	QSlider* scrubBar;
+	QComboBox* speedBox;
+	QLabel* playbackLabel;
+
+	// 样本缓冲区：仪表显示只取最新样本，日志记录读取全部样本
+	SampleRing<Sample> displayRing;
+	SampleRing<Sample> logRing;
+
+	// 日志记录器及其后台写入线程（消费 logRing，磁盘写入不占用界面线程）
 	Logger logger;
+	AsyncLogWriter logWriter;
+
+	// 当前模拟时间
+	double currentTime;
 
 	// 当前数据
 	SensorData currentData;
 
+	// 数据日志和告警面板的模型（各保留最近的若干行）
+	static constexpr int DATA_LOG_ROWS = 10000;
+	static constexpr int ALERT_LOG_ROWS = 5000;
+	LogListModel* dataLogModel;
+	LogListModel* alertLogModel;
+
 	// 仪表盘控件
     GaugeWidget* n1LeftGauge;
     GaugeWidget* n1RightGauge;
@@ -108,8 +199,13 @@ private:
     GaugeWidget* egtRightGauge;
     GaugeWidget* fuelLevelGauge;
 
-	// 异常状态
+	// 异常状态（最新样本的副本，供界面刷新使用）
 	AnomalyState anomalyState;
+
+	// 界面上已显示的内容，未变化时不重复设置控件
+	int shownIndicator;          // 指示灯状态：0 全灭，1 启动，2 运行，-1 未设置
+	int shownFuelFlowState;      // 燃油流速显示：0 正常，1 超速，-1 未设置
+	QString shownFuelFlowText;
 };
 
 #endif
@@ -1,7 +1,7 @@
 #pragma once
 #ifndef ENGINESTATE_H
 #define ENGINESTATE_H
-#include <QString>
+#include <cstdint>
 
 // 发动机状态
 enum class EnginePhase {
@@ -64,6 +64,34 @@ struct AnomalyState {
 	}
 };
 
+// 异常状态比较（判断界面是否需要刷新）
+inline bool operator==(const AnomalyState& a, const AnomalyState& b) {
+    return a.N1LS1Fail == b.N1LS1Fail && a.N1RS1Fail == b.N1RS1Fail
+        && a.N1LS2Fail == b.N1LS2Fail && a.N1RS2Fail == b.N1RS2Fail
+        && a.EGTLS1Fail == b.EGTLS1Fail && a.EGTRS1Fail == b.EGTRS1Fail
+        && a.EGTLS2Fail == b.EGTLS2Fail && a.EGTRS2Fail == b.EGTRS2Fail
+        && a.FuelSFail == b.FuelSFail
+        && a.N1OverSpeedLevel == b.N1OverSpeedLevel && a.EGTOverSpeedLevel == b.EGTOverSpeedLevel
+        && a.LowFuel == b.LowFuel && a.FFOverSpeed == b.FFOverSpeed;
+}
+inline bool operator!=(const AnomalyState& a, const AnomalyState& b) {
+    return !(a == b);
+}
+
+// 模拟核心发布给各消费者的带时间戳样本
+struct Sample {
+    uint64_t tick;           // 步数
+    double time;             // 模拟时间
+    bool stepped;            // 是否由时间步产生（指令产生的状态变化为 false）
+    bool running;            // 是否正在运行
+    SensorData data;         // 传感器数据
+    AnomalyState anomaly;    // 异常状态
+    uint32_t alerts;         // 本步触发的告警位（第 i 位对应 AlertId i，仅时间步样本有效）
+
+    Sample() : tick(0), time(0.0), stepped(false), running(false), alerts(0) {
+    }
+};
+
 // 常量
 constexpr double RATED_RPM = 40000.0;      // 额定转速
 constexpr double MAX_FUEL = 20000.0;       // 满油
@@ -73,65 +101,4 @@ constexpr double TEMPRATURE = 20.0;        // 环境温度
 constexpr double STOP_DURATION = 10.0; // 10秒停车时间
 
 
-// 按钮状态样式定义
-// 普通状态（非报警）- 灰色基底
-const QString NORMAL_BTN_STYLE = R"(
-    QPushButton {
-        background-color: #333333;
-        color: white;
-        border: 1px solid #666666;
-        border-radius: 5px;
-    }
-    QPushButton:hover {
-        background-color: #444444;
-    }
-    QPushButton:pressed {
-        background-color: #555555;
-        border: 2px solid #FF9800;
-    }
-)";
-
-// 报警状态1 - 白色（高对比度白，适配深色基底）
-const QString CHECKED_BTN_STYLE_WHITE = R"(
-    QPushButton {
-        background-color: #FFFFFF;
-        color: #222222; /* 黑色文字保证可读性 */
-        border: 2px solid #EEEEEE;
-        border-radius: 5px;
-        font-weight: bold;
-    }
-    QPushButton:hover {
-        background-color: #F5F5F5;
-    }
-)";
-
-// 报警状态2 - 琥珀色/黄色（预警级别）
-const QString CHECKED_BTN_STYLE_AMBER = R"(
-    QPushButton {
-        background-color: #FFC107;
-        color: #222222; /* 黑色文字保证可读性 */
-        border: 2px solid #FFA000;
-        border-radius: 5px;
-        font-weight: bold;
-    }
-    QPushButton:hover {
-        background-color: #FFD54F;
-    }
-)";
-
-// 报警状态3 - 红色（紧急级别，保留你原有样式）
-const QString CHECKED_BTN_STYLE_RED = R"(
-    QPushButton {
-        background-color: #F44336;
-        color: white;
-        border: 2px solid #FF5252;
-        border-radius: 5px;
-        font-weight: bold;
-    }
-    QPushButton:hover {
-        background-color: #EF5350;
-    }
-)";
-
-
 #endif // ENGINESTATE_H
\ No newline at end of file
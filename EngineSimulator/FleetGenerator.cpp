@@ -0,0 +1,517 @@
+#include "FleetGenerator.h"
+#include "Checkpoint.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr uint8_t THRUST_INCREASE = 1 << 0;
+constexpr uint8_t THRUST_DECREASE = 1 << 1;
+
+constexpr uint8_t PHASE_IDLE = static_cast<uint8_t>(EnginePhase::Idle);
+constexpr uint8_t PHASE_STARTING = static_cast<uint8_t>(EnginePhase::Starting);
+constexpr uint8_t PHASE_STABLE = static_cast<uint8_t>(EnginePhase::Stable);
+constexpr uint8_t PHASE_STOPPING = static_cast<uint8_t>(EnginePhase::Stopping);
+
+// 停车衰减曲线的分母（底数 0.05 的对数）
+const double LOG10_STOP_BASE = std::log10(0.05);
+
+const double LN_10 = std::log(10.0);
+
+// 噪声系数范围 [0.99, 1.01)，判断阶段切换窗口时再放宽一点
+constexpr double NOISE_LOW = 0.989;
+constexpr double NOISE_HIGH = 1.011;
+
+// 启动阶段 N1 加噪声后可能达到 95% 的最早时间（启动曲线 N1 = 57.5·lg(t-1) + 50）
+const double STARTING_REACH_TIME =
+    1.0 + std::pow(10.0, (95.0 / NOISE_HIGH - 50.0) * RATED_RPM / (23000.0 * 100.0));
+
+// 切换窗口之前留出的余量（步），覆盖时间累加的舍入误差
+constexpr uint64_t EVENT_MARGIN = 2;
+
+// 启动阶段从 0 时刻起的累计耗油：前 2 秒流速 5t，之后为 42·lg(t-1) + 10 的积分，lgt = log10(t - 1)
+double startingFuelUsed(double t, double lgt) {
+    if (t < 2.0) return 2.5 * t * t;
+    return 10.0 + 42.0 * ((t - 1.0) * lgt - (t - 2.0) / LN_10) + 10.0 * (t - 2.0);
+}
+
+// 从 anchorTick 起经过 seconds 秒对应的步数，减去余量（不早于 soonest）
+uint64_t ticksAfter(uint64_t anchorTick, double seconds, uint64_t soonest) {
+    if (!(seconds > 0.0)) return soonest;
+    const double steps = std::min(std::floor(seconds / TIME_STEP), 1e15);
+    const uint64_t tick = anchorTick + static_cast<uint64_t>(steps);
+    return tick > soonest + EVENT_MARGIN ? tick - EVENT_MARGIN : soonest;
+}
+
+} // namespace
+
+// 构造函数初始化：全部发动机处于未启动状态
+template <typename Rng>
+BasicFleetGenerator<Rng>::BasicFleetGenerator(size_t engineCount, size_t enginesPerUnit, uint64_t seed)
+    : rng(seed), currentSeed(seed), stepIndex(0), unitSize(enginesPerUnit == 0 ? 1 : enginesPerUnit),
+      kernels(KernelPath::Auto) {
+    const SensorData initial;
+    n1Values.assign(engineCount, initial.n1LeftAverage);
+    egtValues.assign(engineCount, initial.egtLeftAverage);
+    fuelFlowValues.assign(engineCount, initial.fuelFlow);
+    fuelLevelValues.assign(engineCount, initial.fuelLevel);
+    elapsed.assign(engineCount, initial.elapsedTime);
+    phases.assign(engineCount, PHASE_IDLE);
+    lastPhases.assign(engineCount, PHASE_IDLE);
+    egtOverTemps.assign(engineCount, 0);
+    anchorN1 = n1Values;
+    anchorEgt = egtValues;
+    anchorFuelFlow = fuelFlowValues;
+    anchorTime = elapsed;
+    anchorTick.assign(engineCount, 0);
+    fuelTick.assign(engineCount, 0);
+    fuelAnchorLevel = fuelLevelValues;
+    fuelAnchorUsed.assign(engineCount, 0.0);
+    thrustFlags.assign(engineCount, 0);
+    curveArgs.reserve(engineCount * 2);
+    noiseBits.resize(engineCount * 3);
+    deriveNoiseKeys();
+}
+
+// 重新播种
+template <typename Rng>
+void BasicFleetGenerator<Rng>::seed(uint64_t value) {
+    rng.seed(value);
+    currentSeed = value;
+    deriveNoiseKeys();
+}
+
+// 噪声 key：每台发动机的每个通道一条独立的计数器随机数流
+template <typename Rng>
+void BasicFleetGenerator<Rng>::deriveNoiseKeys() {
+    const size_t count = size();
+    noiseKeys.resize(count * 3);
+    for (size_t c = 0; c < 3; ++c) {
+        for (size_t i = 0; i < count; ++i) {
+            noiseKeys[c * count + i] = counterStreamKey(currentSeed, i * 3 + c);
+        }
+    }
+}
+template <typename Rng>
+uint64_t BasicFleetGenerator<Rng>::seedValue() const {
+    return currentSeed;
+}
+
+// 批量计算内核
+template <typename Rng>
+void BasicFleetGenerator<Rng>::setKernelPath(KernelPath path) {
+    kernels = path;
+}
+template <typename Rng>
+KernelPath BasicFleetGenerator<Rng>::kernelPath() const {
+    return kernels;
+}
+
+// 规模
+template <typename Rng>
+size_t BasicFleetGenerator<Rng>::size() const {
+    return n1Values.size();
+}
+template <typename Rng>
+size_t BasicFleetGenerator<Rng>::unitCount() const {
+    return (n1Values.size() + unitSize - 1) / unitSize;
+}
+template <typename Rng>
+size_t BasicFleetGenerator<Rng>::enginesPerUnit() const {
+    return unitSize;
+}
+
+// 检查点：发生器按对象内存原样保存，恢复后的随机序列与保存时逐位相同
+template <typename Rng>
+void BasicFleetGenerator<Rng>::saveState(CheckpointWriter& writer) const {
+    writer.put(rng);
+    writer.put(currentSeed);
+    writer.put(stepIndex);
+    writer.put(static_cast<uint64_t>(unitSize));
+    writer.putVector(n1Values);
+    writer.putVector(egtValues);
+    writer.putVector(fuelFlowValues);
+    writer.putVector(fuelLevelValues);
+    writer.putVector(elapsed);
+    writer.putVector(phases);
+    writer.putVector(lastPhases);
+    writer.putVector(egtOverTemps);
+    writer.putVector(anchorN1);
+    writer.putVector(anchorEgt);
+    writer.putVector(anchorFuelFlow);
+    writer.putVector(anchorTime);
+    writer.putVector(anchorTick);
+    writer.putVector(fuelTick);
+    writer.putVector(fuelAnchorLevel);
+    writer.putVector(fuelAnchorUsed);
+    writer.putVector(thrustFlags);
+}
+
+// 恢复检查点：发动机台数和编组必须与保存时一致
+template <typename Rng>
+bool BasicFleetGenerator<Rng>::loadState(CheckpointReader& reader) {
+    const size_t count = size();
+    uint64_t units = 0;
+    if (!reader.get(rng) || !reader.get(currentSeed) || !reader.get(stepIndex)
+        || !reader.get(units) || units != unitSize) {
+        return false;
+    }
+    deriveNoiseKeys();
+    return reader.getVector(n1Values, count) && reader.getVector(egtValues, count)
+        && reader.getVector(fuelFlowValues, count) && reader.getVector(fuelLevelValues, count)
+        && reader.getVector(elapsed, count) && reader.getVector(phases, count)
+        && reader.getVector(lastPhases, count) && reader.getVector(egtOverTemps, count)
+        && reader.getVector(anchorN1, count) && reader.getVector(anchorEgt, count)
+        && reader.getVector(anchorFuelFlow, count) && reader.getVector(anchorTime, count)
+        && reader.getVector(anchorTick, count) && reader.getVector(fuelTick, count)
+        && reader.getVector(fuelAnchorLevel, count) && reader.getVector(fuelAnchorUsed, count)
+        && reader.getVector(thrustFlags, count);
+}
+
+// 生成 [0, bound) 区间内的随机数
+template <typename Rng>
+double BasicFleetGenerator<Rng>::randomBounded(double bound) {
+    return uniform01(rng) * bound;
+}
+
+// 以当前值作为稳态保持或停车衰减的起点
+template <typename Rng>
+void BasicFleetGenerator<Rng>::captureAnchor(size_t engine) {
+    anchorN1[engine] = n1Values[engine];
+    anchorEgt[engine] = egtValues[engine];
+    anchorFuelFlow[engine] = fuelFlowValues[engine];
+    anchorTime[engine] = elapsed[engine];
+    anchorTick[engine] = stepIndex;
+    captureFuelAnchor(engine);
+}
+
+// 以当前燃油余量作为燃油积分的起点
+template <typename Rng>
+void BasicFleetGenerator<Rng>::captureFuelAnchor(size_t engine) {
+    const double t = elapsed[engine];
+    fuelTick[engine] = stepIndex;
+    fuelAnchorLevel[engine] = fuelLevelValues[engine];
+    fuelAnchorUsed[engine] = phases[engine] == PHASE_STARTING
+        ? startingFuelUsed(t, t >= 2.0 ? std::log10(t - 1.0) : 0.0) : 0.0;
+}
+
+// 控制接口实现
+template <typename Rng>
+void BasicFleetGenerator<Rng>::startSequence(size_t unit) {
+    const size_t end = std::min(size(), (unit + 1) * unitSize);
+    for (size_t i = unit * unitSize; i < end; ++i) {
+        if (phases[i] == PHASE_IDLE) {
+            phases[i] = PHASE_STARTING;
+            elapsed[i] = 0.0; // 重置时间
+            captureAnchor(i);
+        }
+    }
+}
+template <typename Rng>
+void BasicFleetGenerator<Rng>::stopSequence(size_t unit) {
+    const size_t end = std::min(size(), (unit + 1) * unitSize);
+    for (size_t i = unit * unitSize; i < end; ++i) {
+        if (phases[i] != PHASE_IDLE && phases[i] != PHASE_STOPPING) {
+            lastPhases[i] = phases[i];
+            phases[i] = PHASE_STOPPING;
+            fuelFlowValues[i] = 0.0;
+            captureAnchor(i); // 保存停车瞬间的状态作为衰减起点
+        }
+    }
+}
+template <typename Rng>
+void BasicFleetGenerator<Rng>::setIncreaseThrust(size_t unit, bool val) {
+    const size_t end = std::min(size(), (unit + 1) * unitSize);
+    for (size_t i = unit * unitSize; i < end; ++i) {
+        thrustFlags[i] = val ? (thrustFlags[i] | THRUST_INCREASE) : (thrustFlags[i] & ~THRUST_INCREASE);
+    }
+}
+template <typename Rng>
+void BasicFleetGenerator<Rng>::setDecreaseThrust(size_t unit, bool val) {
+    const size_t end = std::min(size(), (unit + 1) * unitSize);
+    for (size_t i = unit * unitSize; i < end; ++i) {
+        thrustFlags[i] = val ? (thrustFlags[i] | THRUST_DECREASE) : (thrustFlags[i] & ~THRUST_DECREASE);
+    }
+}
+template <typename Rng>
+void BasicFleetGenerator<Rng>::startAll() {
+    for (size_t unit = 0; unit < unitCount(); ++unit) {
+        startSequence(unit);
+    }
+}
+template <typename Rng>
+void BasicFleetGenerator<Rng>::stopAll() {
+    for (size_t unit = 0; unit < unitCount(); ++unit) {
+        stopSequence(unit);
+    }
+}
+
+// 推进一个时间步长
+template <typename Rng>
+void BasicFleetGenerator<Rng>::step() {
+    ++stepIndex;
+    evaluate();
+
+    // 推力偏移量（作用于稳态保持值，下一步生效），燃油从当前余量起按新流速计算
+    const size_t count = size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!thrustFlags[i]) continue;
+        if (thrustFlags[i] & THRUST_INCREASE) {
+            anchorFuelFlow[i] += 1.0; // 每次增加1 lbs/s
+            anchorN1[i] *= (1 + randomBounded(0.02) + 0.03);
+            anchorEgt[i] *= (1 + randomBounded(0.02) + 0.03);
+        }
+        if (thrustFlags[i] & THRUST_DECREASE) {
+            anchorFuelFlow[i] -= 1.0; // 每次减少1 lbs/s
+            anchorN1[i] *= (1 + randomBounded(0.02) - 0.05);
+            anchorEgt[i] *= (1 + randomBounded(0.02) - 0.05);
+        }
+        thrustFlags[i] = 0; // 重置标志
+        captureFuelAnchor(i);
+    }
+
+    // 检查并更新阶段
+    checkPhase();
+}
+
+// 按阶段起点计算第 stepIndex 步的数据
+// 分四遍处理：时间与曲线参数 -> 批量 log10 -> 逐台按阶段赋值（含燃油积分） -> 批量噪声
+template <typename Rng>
+void BasicFleetGenerator<Rng>::evaluate() {
+    const size_t count = size();
+    const uint64_t tick = stepIndex;
+
+    // 第一遍：阶段内时间（稳态时停在进入稳态的时刻），收集需要 log10 的曲线参数
+    // 参数按发动机顺序排列：启动阶段 1 个（三条曲线和耗油共用），停车阶段 2 个（N1、EGT）
+    curveArgs.clear();
+    for (size_t i = 0; i < count; ++i) {
+        elapsed[i] = phases[i] == PHASE_STABLE ? anchorTime[i]
+            : anchorTime[i] + static_cast<double>(tick - anchorTick[i]) * TIME_STEP;
+        if (phases[i] == PHASE_STARTING && elapsed[i] >= 2.0) {
+            curveArgs.push_back(elapsed[i] - 1.0);
+        }
+        else if (phases[i] == PHASE_STOPPING) {
+            const double stopTime = elapsed[i] - anchorTime[i];
+            curveArgs.push_back(0.05 + 15.0 * stopTime / anchorN1[i]);
+            curveArgs.push_back(0.05 + 150.0 * stopTime / anchorEgt[i]);
+        }
+    }
+
+    // 第二遍：批量 log10（原地）
+    log10Kernel(kernels, curveArgs.data(), curveArgs.data(), curveArgs.size());
+
+    // 第三遍：根据当前阶段计算数据，按收集顺序取回对数值
+    const double* lg = curveArgs.data();
+    for (size_t i = 0; i < count; ++i) {
+        switch (phases[i]) {
+            // 保持起点的值，不耗油
+        case PHASE_IDLE:
+            n1Values[i] = anchorN1[i];
+            egtValues[i] = anchorEgt[i];
+            fuelFlowValues[i] = anchorFuelFlow[i];
+            fuelLevelValues[i] = fuelAnchorLevel[i];
+            break;
+            // 启动阶段
+        case PHASE_STARTING: {
+            const double t = elapsed[i];
+            double used;
+            if (t < 2.0) {
+                // 线性增长
+                n1Values[i] = 10000.0 * t * 100.0 / RATED_RPM;
+                egtValues[i] = TEMPRATURE;
+                fuelFlowValues[i] = 5.0 * t;
+                used = startingFuelUsed(t, 0.0);
+            }
+            else {
+                const double lgt = *lg++;
+                n1Values[i] = 23000.0 * lgt * 100.0 / RATED_RPM + 50.0;
+                egtValues[i] = 900.0 * lgt + TEMPRATURE;
+                fuelFlowValues[i] = 42 * lgt + 10.0;
+                used = startingFuelUsed(t, lgt);
+            }
+            fuelLevelValues[i] = fuelAnchorLevel[i] - (used - fuelAnchorUsed[i]);
+            // 处理超温1状态
+            if (egtOverTemps[i]) {
+                egtValues[i] += 840.0;
+            }
+            break;
+        }
+            // 达到稳态：保持稳态起点的值，燃油按保持的流速线性消耗
+        case PHASE_STABLE:
+            n1Values[i] = anchorN1[i];
+            egtValues[i] = anchorEgt[i];
+            fuelFlowValues[i] = anchorFuelFlow[i];
+            fuelLevelValues[i] = fuelAnchorLevel[i]
+                - anchorFuelFlow[i] * (static_cast<double>(tick - fuelTick[i]) * TIME_STEP);
+            break;
+            // 停车阶段：自定义对数衰减函数，底数为0.05；停车时流速已置零
+        case PHASE_STOPPING:
+            n1Values[i] = anchorN1[i] * lg[0] / LOG10_STOP_BASE;
+            egtValues[i] = (anchorEgt[i] - TEMPRATURE) * lg[1] / LOG10_STOP_BASE + TEMPRATURE;
+            fuelFlowValues[i] = anchorFuelFlow[i];
+            fuelLevelValues[i] = fuelAnchorLevel[i];
+            lg += 2;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 第四遍：随机扰动，所有噪声均分布在±1%内；随机数由各通道的 key 和步数直接得到
+    for (size_t j = 0; j < noiseBits.size(); ++j) {
+        noiseBits[j] = counterRandom(noiseKeys[j], tick);
+    }
+    noiseKernel(kernels, n1Values.data(), noiseBits.data(), count);
+    noiseKernel(kernels, egtValues.data(), noiseBits.data() + count, count);
+    noiseKernel(kernels, fuelFlowValues.data(), noiseBits.data() + 2 * count, count);
+}
+
+// 快进：跳到下一个可能发生事件的窗口之前，窗口内逐步推进
+template <typename Rng>
+bool BasicFleetGenerator<Rng>::seek(uint64_t tick) {
+    if (tick <= stepIndex) return false;
+    while (stepIndex < tick) {
+        const uint64_t next = std::min(nextEventTick(), tick);
+        if (next > stepIndex + 1) {
+            // 跳过的步只改变步数，之后的数据仍由阶段起点算出
+            stepIndex = next - 1;
+        }
+        step();
+    }
+    return true;
+}
+
+template <typename Rng>
+uint64_t BasicFleetGenerator<Rng>::stepCount() const {
+    return stepIndex;
+}
+
+template <typename Rng>
+bool BasicFleetGenerator<Rng>::thrustPending() const {
+    return std::any_of(thrustFlags.begin(), thrustFlags.end(), [](uint8_t flags) { return flags != 0; });
+}
+
+// 与 evaluate() 中稳态分支和噪声的运算顺序相同
+template <typename Rng>
+void BasicFleetGenerator<Rng>::stableSample(size_t engine, uint64_t tick,
+    double& n1, double& egt, double& fuelFlow, double& fuelLevel) const {
+    const size_t count = size();
+    n1 = anchorN1[engine] * noiseFactor(counterRandom(noiseKeys[engine], tick));
+    egt = anchorEgt[engine] * noiseFactor(counterRandom(noiseKeys[count + engine], tick));
+    fuelFlow = anchorFuelFlow[engine] * noiseFactor(counterRandom(noiseKeys[2 * count + engine], tick));
+    fuelLevel = fuelAnchorLevel[engine]
+        - anchorFuelFlow[engine] * (static_cast<double>(tick - fuelTick[engine]) * TIME_STEP);
+}
+
+// 最早可能发生阶段切换的步数：启动阶段为 N1 加噪声可能达到 95% 的时刻，
+// 停车阶段为超时和转速、温度加噪声可能降到门限的时刻中较早者；稳态和未启动没有自发切换
+template <typename Rng>
+uint64_t BasicFleetGenerator<Rng>::nextEventTick() const {
+    const size_t count = size();
+    const uint64_t soonest = stepIndex + 1;
+    uint64_t next = UINT64_MAX;
+    for (size_t begin = 0; begin < count; begin += unitSize) {
+        const size_t end = std::min(count, begin + unitSize);
+        const uint8_t unitPhase = phases[begin];
+        for (size_t i = begin; i < end; ++i) {
+            // 待执行的推力调整或组内阶段不一致：逐步推进
+            if (thrustFlags[i] || phases[i] != unitPhase) return soonest;
+        }
+
+        if (unitPhase == PHASE_STARTING) {
+            // 组内全部发动机都达到才切换，取各台最早时刻中最晚的
+            uint64_t reach = soonest;
+            for (size_t i = begin; i < end; ++i) {
+                reach = std::max(reach, ticksAfter(anchorTick[i], STARTING_REACH_TIME - anchorTime[i], soonest));
+            }
+            next = std::min(next, reach);
+        }
+        else if (unitPhase == PHASE_STOPPING) {
+            uint64_t timeout = UINT64_MAX;
+            uint64_t settle = soonest;
+            for (size_t i = begin; i < end; ++i) {
+                timeout = std::min(timeout, ticksAfter(anchorTick[i], STOP_DURATION, soonest));
+                // 衰减曲线到达 n1 <= 0.1、egt <= 20.5（除以噪声下限）所需的停车时间，起点异常时不作估计
+                double seconds = 0.0;
+                const double egtSpan = anchorEgt[i] - TEMPRATURE;
+                if (anchorN1[i] > 0.0 && egtSpan > 0.0) {
+                    const double n1Arg = std::pow(10.0, 0.1 / NOISE_LOW * LOG10_STOP_BASE / anchorN1[i]);
+                    const double egtArg = std::pow(10.0, (20.5 / NOISE_LOW - TEMPRATURE) * LOG10_STOP_BASE / egtSpan);
+                    seconds = std::max((n1Arg - 0.05) * anchorN1[i] / 15.0, (egtArg - 0.05) * anchorEgt[i] / 150.0);
+                }
+                settle = std::max(settle, ticksAfter(anchorTick[i], seconds, soonest));
+            }
+            next = std::min(next, std::min(timeout, settle));
+        }
+        if (next == soonest) break;
+    }
+    return next;
+}
+
+// 检查并更新各组阶段：组内全部发动机满足条件时同时切换
+template <typename Rng>
+void BasicFleetGenerator<Rng>::checkPhase() {
+    const size_t count = size();
+    for (size_t begin = 0; begin < count; begin += unitSize) {
+        const size_t end = std::min(count, begin + unitSize);
+        const uint8_t unitPhase = phases[begin];
+
+        if (unitPhase == PHASE_STARTING) {
+            bool reached = true;
+            for (size_t i = begin; i < end && reached; ++i) {
+                reached = phases[i] == PHASE_STARTING && n1Values[i] >= 95.0;
+            }
+            if (reached) {
+                for (size_t i = begin; i < end; ++i) {
+                    phases[i] = PHASE_STABLE;
+                    // 保存稳态数据作为保持值
+                    captureAnchor(i);
+                }
+            }
+        }
+        else if (unitPhase == PHASE_STOPPING) {
+            // 条件1：停车时间超过10秒
+            // 条件2：转速已降到很低（< 1%），温度回到室温附近
+            bool timeout = false;
+            bool settled = true;
+            for (size_t i = begin; i < end; ++i) {
+                if (phases[i] != PHASE_STOPPING) {
+                    settled = false;
+                    continue;
+                }
+                timeout = timeout || elapsed[i] - anchorTime[i] >= STOP_DURATION;
+                settled = settled && n1Values[i] <= 0.1 && egtValues[i] <= (TEMPRATURE + 0.5);
+            }
+            if (timeout || settled) {
+                for (size_t i = begin; i < end; ++i) {
+                    phases[i] = PHASE_IDLE;
+                    // 重置所有值到完全停止状态，作为未启动时的保持值
+                    n1Values[i] = 0.0;
+                    egtValues[i] = TEMPRATURE; // 回到室温
+                    fuelFlowValues[i] = 0.0;
+                    egtOverTemps[i] = 0;
+                    captureAnchor(i);
+                }
+            }
+        }
+    }
+}
+
+// 写入单台发动机的状态
+template <typename Rng>
+void BasicFleetGenerator<Rng>::setEngine(size_t engine, double n1, double egt, double fuelFlow, double fuelLevel,
+    EnginePhase phase, EnginePhase lastPhase, double elapsedTime, bool egtOverTemp) {
+    n1Values[engine] = n1;
+    egtValues[engine] = egt;
+    fuelFlowValues[engine] = fuelFlow;
+    fuelLevelValues[engine] = fuelLevel;
+    phases[engine] = static_cast<uint8_t>(phase);
+    lastPhases[engine] = static_cast<uint8_t>(lastPhase);
+    elapsed[engine] = elapsedTime;
+    egtOverTemps[engine] = egtOverTemp ? 1 : 0;
+    captureAnchor(engine);
+}
+
+// 显式实例化：默认 xoshiro256++，另提供标准库 mt19937_64 策略
+template class BasicFleetGenerator<Xoshiro256PlusPlus>;
+template class BasicFleetGenerator<std::mt19937_64>;
@@ -0,0 +1,157 @@
+#ifndef FLEETGENERATOR_H
+#define FLEETGENERATOR_H
+
+#include "EngineState.h"
+#include "Random.h"
+#include "SimdKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CheckpointWriter;
+class CheckpointReader;
+
+// 多发动机数据生成器（结构数组布局）
+// N 台发动机的每个通道（N1、EGT、燃油流速、燃油余量、阶段、阶段起点时间等）各存一段连续数组，
+// 一次 step() 同时推进全部发动机。发动机按 enginesPerUnit 台编为一组（一架飞机），
+// 组内共用指令和阶段切换：全部达到稳态转速才进入稳态，停车同时完成。
+// 双发 DataGenerator 即为 2 台 1 组的视图。
+// 启动/停车曲线的 log10 和随机扰动按批交给 SimdKernels 计算，默认使用 CPU 支持的最快实现。
+//
+// 每一步的数据只取决于阶段起点（锚点）和步数：启动/停车曲线是阶段内时间的解析函数，
+// 燃油余量按名义流速对时间的积分计算，噪声由种子和步数经计数器随机数直接得到。
+// 因此 seek() 可以向前跳过不会发生阶段切换的区间，直接求出之后任意一步的状态，与逐步推进逐位一致。
+template <typename Rng>
+class BasicFleetGenerator {
+public:
+    BasicFleetGenerator(size_t engineCount, size_t enginesPerUnit = 1, uint64_t seed = randomSeed());
+
+    // 重新播种
+    void seed(uint64_t value);
+    uint64_t seedValue() const;
+
+    // 批量计算内核（Scalar 与标准库 log10 结果一致，可跨机器复现）
+    void setKernelPath(KernelPath path);
+    KernelPath kernelPath() const;
+
+    // 规模
+    size_t size() const;
+    size_t unitCount() const;
+    size_t enginesPerUnit() const;
+
+    // 控制接口（按组）
+    void startSequence(size_t unit);
+    void stopSequence(size_t unit);
+    void setIncreaseThrust(size_t unit, bool val);
+    void setDecreaseThrust(size_t unit, bool val);
+    void startAll();
+    void stopAll();
+
+    // 推进一个时间步长
+    void step();
+
+    // 快进到第 tick 步，结果与连续调用 step() 逐位一致。
+    // 只能向前：tick 不晚于当前步时不做任何事并返回 false（需要回到之前的步时先恢复检查点）。
+    // 只在阶段可能切换的窗口内（启动末段约 1 秒、停车段不超过 10 秒）逐步推进，其余区间直接跳过
+    bool seek(uint64_t tick);
+
+    // 自构造以来推进的步数
+    uint64_t stepCount() const;
+
+    // 检查并更新各组阶段
+    void checkPhase();
+
+    // 写入单台发动机的状态，同时作为稳态/停车的起点
+    void setEngine(size_t engine, double n1, double egt, double fuelFlow, double fuelLevel,
+        EnginePhase phase, EnginePhase lastPhase, double elapsedTime, bool egtOverTemp);
+
+    // 检查点：全部通道、推力标志和随机数发生器状态（计算内核选择不属于状态，不保存）
+    void saveState(CheckpointWriter& writer) const;
+    bool loadState(CheckpointReader& reader);
+
+    // 通道只读访问（长度均为 size()）
+    const double* n1() const { return n1Values.data(); }
+    const double* egt() const { return egtValues.data(); }
+    const double* fuelFlow() const { return fuelFlowValues.data(); }
+    const double* fuelLevel() const { return fuelLevelValues.data(); }
+    const double* elapsedTime() const { return elapsed.data(); }
+    const double* phaseStartTime() const { return anchorTime.data(); }
+    const uint8_t* phase() const { return phases.data(); }
+    const uint8_t* lastPhase() const { return lastPhases.data(); }
+    const uint8_t* egtOverTemp() const { return egtOverTemps.data(); }
+
+    // 稳态保持值（停车时为衰减起点）及是否有待执行的推力调整
+    const double* holdN1() const { return anchorN1.data(); }
+    const double* holdEgt() const { return anchorEgt.data(); }
+    const double* holdFuelFlow() const { return anchorFuelFlow.data(); }
+    bool thrustPending() const;
+
+    // 稳态且没有待执行的推力调整时，第 engine 台第 tick 步的数据（不推进，与推进到该步的结果逐位一致）
+    void stableSample(size_t engine, uint64_t tick, double& n1, double& egt, double& fuelFlow, double& fuelLevel) const;
+
+private:
+    // 生成 [0, bound) 区间内的随机数
+    double randomBounded(double bound);
+
+    // 以当前值作为稳态保持或停车衰减的起点（同时作为阶段时间和燃油的起点）
+    void captureAnchor(size_t engine);
+
+    // 以当前燃油余量作为燃油积分的起点（流速改变时）
+    void captureFuelAnchor(size_t engine);
+
+    // 按阶段起点计算第 stepIndex 步的全部数据
+    void evaluate();
+
+    // 之后最早可能发生阶段切换（或推力调整）的步数，之前的步可以跳过
+    uint64_t nextEventTick() const;
+
+    // 由 seed 派生各发动机、各通道的噪声 key
+    void deriveNoiseKeys();
+
+    // 随机数发生器及其种子（整个机队共用一个实例内的发生器，用于推力调整）
+    Rng rng;
+    uint64_t currentSeed;
+
+    // 已推进的步数，噪声的计数器
+    uint64_t stepIndex;
+
+    size_t unitSize;
+    KernelPath kernels;
+
+    // 当前值
+    std::vector<double> n1Values;
+    std::vector<double> egtValues;
+    std::vector<double> fuelFlowValues;
+    std::vector<double> fuelLevelValues;
+    std::vector<double> elapsed;
+    std::vector<uint8_t> phases;
+    std::vector<uint8_t> lastPhases;
+    std::vector<uint8_t> egtOverTemps;
+
+    // 稳态保持值 / 停车衰减起点，以及对应的阶段起点时间和步数
+    std::vector<double> anchorN1;
+    std::vector<double> anchorEgt;
+    std::vector<double> anchorFuelFlow;
+    std::vector<double> anchorTime;
+    std::vector<uint64_t> anchorTick;
+
+    // 燃油积分起点：起点步数、起点余量、起点时刻的启动阶段累计耗油
+    std::vector<uint64_t> fuelTick;
+    std::vector<double> fuelAnchorLevel;
+    std::vector<double> fuelAnchorUsed;
+
+    // 待执行的推力调整：bit0 增加，bit1 减小
+    std::vector<uint8_t> thrustFlags;
+
+    // 每步复用的批量计算缓冲区：曲线 log10 参数/结果、噪声随机数
+    std::vector<double> curveArgs;
+    std::vector<uint64_t> noiseBits;
+
+    // 噪声 key：通道 c（N1、EGT、燃油流速）的第 i 台发动机为 noiseKeys[c * size() + i]
+    std::vector<uint64_t> noiseKeys;
+};
+
+// 默认使用 xoshiro256++
+using FleetGenerator = BasicFleetGenerator<Xoshiro256PlusPlus>;
+
+#endif // FLEETGENERATOR_H
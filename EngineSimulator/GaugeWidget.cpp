@@ -1,8 +1,13 @@
 #include "GaugeWidget.h"
 #include "EngineState.h"
+#include "SpanTrace.h"
 #include <QFontMetrics>
+#include <algorithm>
 #include <cmath>
 
+// 角度转弧度
+static constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
 // 根据不同的仪表盘类型设置参数
 void GaugeWidget::setupByType() {
     switch (type) {
@@ -10,6 +15,7 @@ void GaugeWidget::setupByType() {
         minValue = currentValue = 0.0;
         maxValue = dangerEnd = 125.0;
         gaugeName = "N1";
+        traceName = "paintEvent N1";
         unit = "%";
 		dangerStart = 105.0;
         break;
@@ -17,6 +23,7 @@ void GaugeWidget::setupByType() {
         minValue = -5.0;
         maxValue = dangerEnd = 1200.0;
         gaugeName = "EGT";
+        traceName = "paintEvent EGT";
         unit = "C";
 		dangerStart = 850.0;
 		currentValue = 20.0;
@@ -25,18 +32,28 @@ void GaugeWidget::setupByType() {
         minValue = dangerStart = 0.0;
         maxValue = currentValue = 20000.0;
         gaugeName = "Fuel Level";
+        traceName = "paintEvent Fuel Level";
         unit = "lbs";
 		dangerEnd = 1000.0;
         break;
     }
     level = AlertLevel::normal;
+    paintedValue = currentValue;
+}
+
+// 跨度追踪名称
+void GaugeWidget::setTraceName(const char* name) {
+    traceName = name;
 }
 
 // 构造函数
 GaugeWidget::GaugeWidget(GaugeType initType, QWidget* parent)
-	: QWidget(parent), level(AlertLevel::normal), type(initType)
+	: QWidget(parent), level(AlertLevel::normal), type(initType),
+    dialCacheLevel(AlertLevel::normal), dialCacheDpr(0.0)
 {
     setMinimumSize(300, 300);
+    // 缓存位图覆盖整个控件，无需 Qt 先擦除背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
     startAngle = 255.0; // 起始角度
     setupByType();
     angle = 7.0;
@@ -47,15 +64,33 @@ GaugeWidget::GaugeWidget(GaugeType initType, QWidget* parent)
 // 更新数据
 void GaugeWidget::updateValue(double newValue) {
     currentValue = newValue;
+
+    // 指针尖端（长度为半径的 2/3）移动不足 1 像素、显示的读数也不变时不重绘
+    const double needleLength = height() / 3.0;
+    const double moved = std::abs(valueToAngle(newValue) - valueToAngle(paintedValue)) * DEG_TO_RAD * needleLength;
+    if (moved < 1.0 && displayedReading(newValue) == displayedReading(paintedValue)) {
+        return;
+    }
+    paintedValue = newValue;
     update(); // 触发重绘
 }
 
 // 更新告警等级
 void GaugeWidget::updateLevel(AlertLevel newLevel) {
+    if (newLevel == level) return;
     level = newLevel;
     update(); // 触发重绘
 }
 
+// 显示的读数（与 drawCurrentSpeed 的限幅和一位小数一致），以 0.1 为单位
+long long GaugeWidget::displayedReading(double value) const {
+    value = std::min(std::max(value, minValue), maxValue);
+    if (type == EGT && value < TEMPRATURE) {
+        value = TEMPRATURE;
+    }
+    return std::llround(value * 10.0);
+}
+
 // 将数值转换为角度
 double GaugeWidget::valueToAngle(double value) const {
     if (value <= minValue) return 0.0;
@@ -79,8 +114,12 @@ void GaugeWidget::initCanvas(QPainter& painter) {
     painter.setRenderHint(QPainter::Antialiasing, true);
     painter.setBrush(QColor(0, 0, 0));
     painter.drawRect(rect());
-    QPoint center(rect().width() / 2, rect().height() * 0.6);
-    painter.translate(center);
+    painter.translate(dialCenter());
+}
+
+// 表盘中心
+QPoint GaugeWidget::dialCenter() const {
+    return QPoint(rect().width() / 2, rect().height() * 0.6);
 }
 
 // 绘制刻度线的圆圈
@@ -220,23 +259,51 @@ void GaugeWidget::drawLogo(QPainter& painter, int radius) {
     painter.drawText(rectLogo, Qt::AlignCenter, gaugeName);
 }
 
+// 绘制静态表盘到缓存位图（按设备像素比放大，高分屏下不模糊）
+void GaugeWidget::renderDial(qreal dpr) {
+    TRACE_SPAN("renderDial");
+    dialCache = QPixmap(size() * dpr);
+    dialCache.setDevicePixelRatio(dpr);
+    dialCache.fill(Qt::black);
+
+    QPainter painter(&dialCache);
+    initCanvas(painter);
+    drawMiddleCircle(painter, radius);
+    drawScale(painter, radius);
+    drawInnerEllipse(painter, 110);
+    drawEllipseOutSkirts(painter, radius + 25);
+    drawLogo(painter, radius);
+    painter.end();
+
+    dialCacheSize = size();
+    dialCacheLevel = level;
+    dialCacheDpr = dpr;
+}
+
 // 重绘事件
 void GaugeWidget::paintEvent(QPaintEvent* event) {
+    TRACE_SPAN(traceName);
 	// 根据燃油量自动调整告警级别
     if(type == FUEL_LEVEL && currentValue < 1000.0 && level != AlertLevel::redWarning) {
 		level = AlertLevel::amberWarning;
 	}
-    QPainter painter(this);
     // 仪表盘半径
     radius = height() / 2;
 
-    initCanvas(painter);
-    drawMiddleCircle(painter, radius);
-    drawScale(painter, radius);
-    drawInnerEllipse(painter, 110);
+    // 静态表盘：缓存失效时重绘
+    const qreal dpr = devicePixelRatioF();
+    if (dialCache.isNull() || dialCacheSize != size() || dialCacheLevel != level || dialCacheDpr != dpr) {
+        renderDial(dpr);
+    }
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, dialCache);
+
+    // 动态部分：指针、中心黑圆（压住指针根部）和读数
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.translate(dialCenter());
     drawPoint(painter, radius);
+    painter.setPen(QPen(Qt::white, 3));
     drawInnerEllipseBlack(painter, 40);
     drawCurrentSpeed(painter);
-    drawEllipseOutSkirts(painter, radius + 25);
-    drawLogo(painter, radius);
 }
\ No newline at end of file
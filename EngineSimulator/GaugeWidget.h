@@ -4,9 +4,12 @@
 #include "EngineState.h"
 #include <QWidget>
 #include <QPainter>
+#include <QPixmap>
 #include <QTimer>
 
 // 仪表盘控件类
+// 表盘、刻度、危险区、外圈和名称等静态部分缓存为位图，只在尺寸、告警等级或设备像素比变化时重绘；
+// 每帧只贴缓存位图，再画指针和读数
 class GaugeWidget : public QWidget {
     Q_OBJECT
 
@@ -24,7 +27,10 @@ public:
 	// 根据不同的仪表盘类型设置参数
 	void setupByType();
 
-	// 更新当前数值和告警等级
+	// 跨度追踪中本仪表重绘的名称（须为字符串字面量），默认按类型区分
+	void setTraceName(const char* name);
+
+	// 更新当前数值和告警等级（指针移动不足 1 像素且读数不变时不重绘）
     void updateValue(double newValue);
     void updateLevel(AlertLevel newLevel);
 
@@ -36,12 +42,14 @@ private:
     double minValue;
     double maxValue;
     double currentValue;
+    double paintedValue;  // 最近一次请求重绘时的数值
     double dangerStart;
     double dangerEnd;
     GaugeType type;
     QString gaugeName;
     QString unit;
 	AlertLevel level;
+    const char* traceName;
 
     int startAngle; // 起始角度
     double angle;   // 每个刻度的角度值
@@ -49,8 +57,18 @@ private:
     double dangerEndAngle;
     int radius;     // 仪表盘半径
 
+    // 静态表盘缓存及其对应的尺寸、告警等级、设备像素比
+    QPixmap dialCache;
+    QSize dialCacheSize;
+    AlertLevel dialCacheLevel;
+    qreal dialCacheDpr;
+
+    // 缓存失效时重绘静态表盘
+    void renderDial(qreal dpr);
+
 	// 绘制各个部分的辅助函数
     void initCanvas(QPainter& painter);
+    QPoint dialCenter() const;
     void drawMiddleCircle(QPainter& painter, int radius);
     void drawScale(QPainter& painter, int radius);
     void drawPoint(QPainter& painter, int radius);
@@ -60,6 +78,7 @@ private:
     void drawEllipseOutSkirts(QPainter& painter, int radius);
     void drawLogo(QPainter& painter, int radius);
     double valueToAngle(double value) const;
+    long long displayedReading(double value) const;
     QColor getBackgroundColor() const;
 };
 
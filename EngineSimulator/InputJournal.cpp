@@ -0,0 +1,145 @@
+#include "InputJournal.h"
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+// 读取输入日志，# 开头为注释
+bool loadJournal(const std::string& path, Journal& journal, std::string& error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    journal = Journal();
+    bool hasSeed = false;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') continue;
+
+        const std::string where = path + ":" + std::to_string(lineNumber) + ": ";
+        if (first == "seed") {
+            if (!(fields >> journal.seed)) {
+                error = where + "invalid seed";
+                return false;
+            }
+            hasSeed = true;
+            continue;
+        }
+        if (first == "end") {
+            if (!(fields >> journal.endStep)) {
+                error = where + "invalid end step";
+                return false;
+            }
+            journal.hasEnd = true;
+            continue;
+        }
+
+        JournalEntry entry;
+        std::string name;
+        std::istringstream stepField(first);
+        if (!(stepField >> entry.step)) {
+            error = where + "invalid step \"" + first + "\"";
+            return false;
+        }
+        if (!(fields >> name) || !commandFromName(name, entry.command)) {
+            error = where + "unknown command \"" + name + "\"";
+            return false;
+        }
+        if (!journal.entries.empty() && entry.step < journal.entries.back().step) {
+            error = where + "steps must not decrease";
+            return false;
+        }
+        journal.entries.push_back(entry);
+    }
+    if (!hasSeed) {
+        error = path + ": missing seed";
+        return false;
+    }
+    return true;
+}
+
+// 写入器
+JournalWriter::JournalWriter() : file(nullptr) {
+}
+JournalWriter::~JournalWriter() {
+    if (file) std::fclose(file);
+}
+
+bool JournalWriter::open(const std::string& path, uint64_t seed) {
+    if (file) std::fclose(file);
+    file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+    std::fprintf(file, "# EngineSimulator input journal\nseed %llu\n", static_cast<unsigned long long>(seed));
+    std::fflush(file);
+    return true;
+}
+
+void JournalWriter::record(uint64_t step, Command command) {
+    if (!file) return;
+    std::fprintf(file, "%llu %s\n", static_cast<unsigned long long>(step), commandName(command));
+    std::fflush(file);
+}
+
+void JournalWriter::close(uint64_t endStep) {
+    if (!file) return;
+    std::fprintf(file, "end %llu\n", static_cast<unsigned long long>(endStep));
+    std::fclose(file);
+    file = nullptr;
+}
+
+bool JournalWriter::isOpen() const {
+    return file != nullptr;
+}
+
+// 回放器
+JournalPlayer::JournalPlayer(Journal journal)
+    : data(std::move(journal)), next(0), stepLimit(std::numeric_limits<uint64_t>::max()), mismatch(false) {
+}
+
+void JournalPlayer::setStepLimit(uint64_t steps) {
+    stepLimit = steps;
+}
+
+void JournalPlayer::begin(Simulation& simulation) {
+    simulation.reset(data.seed);
+    next = 0;
+    mismatch = false;
+}
+
+bool JournalPlayer::advance(Simulation& simulation) {
+    const uint64_t step = simulation.stepCount();
+    while (next < data.entries.size() && data.entries[next].step == step) {
+        simulation.apply(data.entries[next].command);
+        ++next;
+    }
+
+    // 有结束标记时回放到结束步数为止，否则到最后一条指令之后引擎停下（或达到步数上限）
+    if (data.hasEnd) {
+        if (step >= data.endStep) return false;
+    }
+    else if (step >= stepLimit) {
+        return false;
+    }
+    if (!simulation.isRunning()) {
+        // 引擎未运行时步数不会增长：还有后续指令说明日志与回放不一致
+        if (next < data.entries.size() || (data.hasEnd && step < data.endStep)) {
+            mismatch = true;
+        }
+        return false;
+    }
+    simulation.step();
+    return true;
+}
+
+bool JournalPlayer::diverged() const {
+    return mismatch;
+}
+
+const Journal& JournalPlayer::journal() const {
+    return data;
+}
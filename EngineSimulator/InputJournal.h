@@ -0,0 +1,82 @@
+#ifndef INPUTJOURNAL_H
+#define INPUTJOURNAL_H
+
+#include "Simulation.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 输入日志（.jnl）
+// 记录随机种子和每条操作指令执行时模拟核心已推进的时间步数（Simulation::stepCount），
+// 据此可在无界面或界面程序中以最快速度逐位一致地重现整个会话。
+// 文件为文本格式，每行一条：
+//   seed <n>            随机种子（首行）
+//   <step> <Command>    在第 step 步之前执行的指令
+//   end <step>          记录结束时的步数（正常关闭时写入）
+struct JournalEntry {
+    uint64_t step;
+    Command command;
+};
+
+struct Journal {
+    uint64_t seed = 0;
+    std::vector<JournalEntry> entries;
+    bool hasEnd = false;
+    uint64_t endStep = 0;
+};
+
+// 读取输入日志
+bool loadJournal(const std::string& path, Journal& journal, std::string& error);
+
+// 输入日志写入器：指令频率很低，每条记录立即落盘，程序异常退出也不丢失
+class JournalWriter {
+public:
+    JournalWriter();
+    ~JournalWriter();
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // 建立日志文件并写入种子（须在模拟核心播种后、执行任何指令和时间步之前调用）
+    bool open(const std::string& path, uint64_t seed);
+
+    // 记录一条指令
+    void record(uint64_t step, Command command);
+
+    // 写入结束步数并关闭
+    void close(uint64_t endStep);
+
+    bool isOpen() const;
+
+private:
+    std::FILE* file;
+};
+
+// 输入日志回放器
+// begin() 把模拟核心重置为日志开始时的状态，之后每次 advance() 先执行到期的指令再推进一步
+class JournalPlayer {
+public:
+    explicit JournalPlayer(Journal journal);
+
+    // 没有结束标记的日志（记录程序异常退出）最多回放的步数，默认不限
+    void setStepLimit(uint64_t steps);
+
+    // 重置模拟核心并开始回放
+    void begin(Simulation& simulation);
+
+    // 推进一步，回放结束时返回 false
+    bool advance(Simulation& simulation);
+
+    // 日志与回放状态不一致（引擎已停，后续指令的步数却无法到达）
+    bool diverged() const;
+
+    const Journal& journal() const;
+
+private:
+    Journal data;
+    size_t next;
+    uint64_t stepLimit;
+    bool mismatch;
+};
+
+#endif // INPUTJOURNAL_H
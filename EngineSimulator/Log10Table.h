@@ -0,0 +1,98 @@
+#ifndef LOG10TABLE_H
+#define LOG10TABLE_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 查表插值 log10（机队 log10 内核的可选实现，见 KernelPath::Table）
+// 启动/停车曲线的参数为 t - 1 和 0.05 + k * s / anchor，随时间步长和发动机参数变化，定义域没有固定上界，
+// 因此按指数/尾数拆分：x = m * 2^e，m 在 [1, 2) 内，log10(x) = (e + log2(m)) * log10(2)。
+// log2(m) 在 [1, 2] 上等分为 N 段，节点值在编译期生成，段内线性插值，
+// N 取使插值误差不超过 LOG10_TABLE_MAX_ERROR（绝对误差，可在构建时定义）的最小 2 的幂。
+// 只用整数和四则运算，任何机器上结果逐位相同。
+
+#ifndef LOG10_TABLE_MAX_ERROR
+#define LOG10_TABLE_MAX_ERROR 1e-6
+#endif
+
+// 查表 log10 相对 std::log10 的绝对误差上限
+constexpr double LOG10_TABLE_ERROR_BOUND = LOG10_TABLE_MAX_ERROR;
+static_assert(LOG10_TABLE_ERROR_BOUND >= 1e-12 && LOG10_TABLE_ERROR_BOUND <= 1e-2,
+    "LOG10_TABLE_MAX_ERROR must be within [1e-12, 1e-2]");
+
+namespace log10table {
+
+constexpr double LOG10_2 = 0.30102999566398119521;
+constexpr double LN_2 = 0.69314718055994530942;
+
+// 编译期 ln(m)，m 在 [1, 2] 内：ln(m) = 2 * atanh(z)，z = (m - 1) / (m + 1) <= 1/3，级数收敛很快
+constexpr double lnSeries(double m) {
+    const double z = (m - 1.0) / (m + 1.0);
+    const double z2 = z * z;
+    double term = z;
+    double sum = 0.0;
+    for (int k = 1; k < 200 && term > 1e-20; k += 2) {
+        sum += term / k;
+        term *= z2;
+    }
+    return 2.0 * sum;
+}
+
+// 线性插值误差上限：log2 在 [1, 2] 上二阶导数的绝对值不超过 1/ln2，
+// 段长 h = 1/N 时误差不超过 h^2 / (8 * ln2)，换算为 log10 再乘 log10(2)；留一半余量给舍入误差
+constexpr size_t segmentsFor(double bound) {
+    size_t segments = 1;
+    while (LOG10_2 / (8.0 * LN_2 * static_cast<double>(segments) * static_cast<double>(segments)) > bound * 0.5) {
+        segments *= 2;
+    }
+    return segments;
+}
+
+constexpr size_t SEGMENTS = segmentsFor(LOG10_TABLE_ERROR_BOUND);
+
+constexpr int segmentBits() {
+    int bits = 0;
+    while ((size_t(1) << bits) < SEGMENTS) ++bits;
+    return bits;
+}
+
+constexpr int SEGMENT_BITS = segmentBits();
+
+// 节点值 log2(1 + i/N)，i = 0..N
+struct Table {
+    double values[SEGMENTS + 1];
+
+    constexpr Table() : values() {
+        for (size_t i = 0; i <= SEGMENTS; ++i) {
+            values[i] = lnSeries(1.0 + static_cast<double>(i) / static_cast<double>(SEGMENTS)) / LN_2;
+        }
+    }
+};
+
+constexpr Table TABLE{};
+static_assert(TABLE.values[0] == 0.0, "log2(1) must be exact");
+
+} // namespace log10table
+
+// 查表 log10；非正数、非规格化数、无穷和 NaN 交给 std::log10
+inline double log10Table(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const uint64_t biased = bits >> 52;
+    if (biased == 0 || biased >= 0x7FF) {
+        return std::log10(x);
+    }
+    constexpr int FRACTION_BITS = 52 - log10table::SEGMENT_BITS;
+    const uint64_t mantissa = bits & 0x000FFFFFFFFFFFFFull;
+    const size_t index = static_cast<size_t>(mantissa >> FRACTION_BITS);
+    const double fraction = static_cast<double>(mantissa & ((uint64_t(1) << FRACTION_BITS) - 1))
+        * (1.0 / static_cast<double>(uint64_t(1) << FRACTION_BITS));
+    const double low = log10table::TABLE.values[index];
+    const double high = log10table::TABLE.values[index + 1];
+    const double log2x = static_cast<double>(static_cast<int>(biased) - 1023) + (low + fraction * (high - low));
+    return log2x * log10table::LOG10_2;
+}
+
+#endif // LOG10TABLE_H
@@ -0,0 +1,64 @@
+#include "LogListModel.h"
+#include <QColor>
+
+// 构造函数：一次性分配全部行
+LogListModel::LogListModel(int capacity, QObject* parent)
+    : QAbstractListModel(parent), rows(capacity > 0 ? capacity : 1), head(0), count(0) {
+}
+
+// 追加一行，已满时先移除最旧的一行
+void LogListModel::append(const QString& text, AlertLevel level) {
+    const int size = static_cast<int>(rows.size());
+    if (count == size) {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        head = (head + 1) % size;
+        --count;
+        endRemoveRows();
+    }
+    beginInsertRows(QModelIndex(), count, count);
+    Row& row = rows[slot(count)];
+    row.text = text;
+    row.level = level;
+    ++count;
+    endInsertRows();
+}
+
+// 清空（保留已分配的缓冲区）
+void LogListModel::clear() {
+    beginResetModel();
+    head = 0;
+    count = 0;
+    endResetModel();
+}
+
+int LogListModel::capacity() const {
+    return static_cast<int>(rows.size());
+}
+
+int LogListModel::slot(int row) const {
+    return (head + row) % static_cast<int>(rows.size());
+}
+
+int LogListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : count;
+}
+
+// 显示文字和告警颜色
+QVariant LogListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= count) {
+        return QVariant();
+    }
+    const Row& row = rows[slot(index.row())];
+    if (role == Qt::DisplayRole) {
+        return row.text;
+    }
+    if (role == Qt::ForegroundRole) {
+        switch (row.level) {
+        case AlertLevel::whiteWarning: return QColor("white");   // 白色警告
+        case AlertLevel::amberWarning: return QColor("#FFBF00"); // 琥珀色警告
+        case AlertLevel::redWarning: return QColor("red");       // 红色警告
+        default: break;
+        }
+    }
+    return QVariant();
+}
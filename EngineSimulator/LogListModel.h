@@ -0,0 +1,44 @@
+#ifndef LOGLISTMODEL_H
+#define LOGLISTMODEL_H
+
+#include "EngineState.h"
+#include <QAbstractListModel>
+#include <QString>
+#include <vector>
+
+// 日志列表模型
+// 行保存在固定容量的环形缓冲区中，满后追加一行即丢弃最旧的一行，
+// 内存占用和追加开销与会话时长无关。每行可带告警级别，用于决定文字颜色
+class LogListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit LogListModel(int capacity, QObject* parent = nullptr);
+
+    // 追加一行（normal 级别使用视图默认颜色）
+    void append(const QString& text, AlertLevel level = AlertLevel::normal);
+
+    // 清空
+    void clear();
+
+    int capacity() const;
+
+    // QAbstractListModel 接口
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    struct Row {
+        QString text;
+        AlertLevel level = AlertLevel::normal;
+    };
+
+    // 第 row 行在环形缓冲区中的位置
+    int slot(int row) const;
+
+    std::vector<Row> rows;
+    int head;   // 最旧一行的位置
+    int count;  // 当前行数
+};
+
+#endif // LOGLISTMODEL_H
@@ -0,0 +1,112 @@
+#include "LogPlayback.h"
+#include "AlertCatalog.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// 打开数据日志并读入同名告警日志
+bool LogPlayback::open(const std::string& path) {
+    close();
+    if (!reader.open(path, true)) {
+        return false;
+    }
+    if (reader.rowCount() == 0) {
+        std::cerr << "Telemetry log has no complete block: " << path << "\n";
+        reader.close();
+        return false;
+    }
+    loadAlerts(telemetrySiblingPath(path, ".log"));
+    return true;
+}
+
+void LogPlayback::close() {
+    reader.close();
+    alertList.clear();
+}
+
+bool LogPlayback::isOpen() const {
+    return reader.isOpen();
+}
+
+double LogPlayback::startTime() const {
+    return reader.blockCount() ? reader.block(0).firstTime : 0.0;
+}
+
+double LogPlayback::endTime() const {
+    return reader.blockCount() ? reader.block(reader.blockCount() - 1).lastTime : 0.0;
+}
+
+size_t LogPlayback::rowCount() const {
+    return reader.rowCount();
+}
+
+bool LogPlayback::indexLoaded() const {
+    return reader.indexLoaded();
+}
+
+// 由一行记录组成样本（记录的是 processData 之后的显示数据）
+bool LogPlayback::sampleAt(double time, Sample& sample) const {
+    if (reader.rowCount() == 0) return false;
+    size_t row = std::min(reader.findRow(time), reader.rowCount() - 1);
+    TelemetryRow record;
+    if (!reader.readRow(row, record)) return false;
+    if (record.time > time && row > 0) {
+        reader.readRow(--row, record);
+    }
+
+    sample = Sample();
+    sample.tick = row;
+    sample.time = record.time;
+    sample.stepped = true;
+    sample.running = record.phase != EnginePhase::Idle;
+    sample.data.n1LeftAverage = record.values[static_cast<int>(TelemetryChannel::N1Left)];
+    sample.data.n1RightAverage = record.values[static_cast<int>(TelemetryChannel::N1Right)];
+    sample.data.egtLeftAverage = record.values[static_cast<int>(TelemetryChannel::EGTLeft)];
+    sample.data.egtRightAverage = record.values[static_cast<int>(TelemetryChannel::EGTRight)];
+    sample.data.fuelLevel = record.values[static_cast<int>(TelemetryChannel::FuelLevel)];
+    sample.data.fuelFlow = record.values[static_cast<int>(TelemetryChannel::FuelFlow)];
+    sample.data.phase = record.phase;
+    sample.data.lastPhase = record.phase;
+    sample.data.elapsedTime = record.time;
+    sample.anomaly = unpackAnomaly(record.anomaly);
+    return true;
+}
+
+const std::vector<PlaybackAlert>& LogPlayback::alerts() const {
+    return alertList;
+}
+
+size_t LogPlayback::alertsUntil(double time) const {
+    auto it = std::upper_bound(alertList.begin(), alertList.end(), time,
+        [](double value, const PlaybackAlert& alert) { return value < alert.time; });
+    return static_cast<size_t>(it - alertList.begin());
+}
+
+// 读入告警日志：每行 "[<时间>s] <目录中的告警文本>"，级别按目录文本查出，其余行（文件头等）跳过
+bool LogPlayback::loadAlerts(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        double time = 0.0;
+        int consumed = 0;
+        if (line.empty() || line[0] != '[' || std::sscanf(line.c_str(), "[%lfs] %n", &time, &consumed) != 1 || consumed == 0) {
+            continue;
+        }
+        const char* message = line.c_str() + consumed;
+        AlertLevel level = AlertLevel::normal;
+        for (const AlertInfo& info : ALERT_CATALOG) {
+            if (std::strcmp(info.message, message) == 0) {
+                level = info.level;
+                break;
+            }
+        }
+        alertList.push_back({ time, level, line });
+    }
+    std::stable_sort(alertList.begin(), alertList.end(),
+        [](const PlaybackAlert& a, const PlaybackAlert& b) { return a.time < b.time; });
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef LOGPLAYBACK_H
+#define LOGPLAYBACK_H
+
+#include "EngineState.h"
+#include "TelemetryLog.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 已记录会话的回放
+// 内存映射二进制数据日志（.tlm）并加载或建立稀疏时间索引（.tlx），同名告警日志（.log）在打开时读入内存。
+// 任意时刻的样本只需一次分桶定位和块内二分，不解析整个文件，拖动进度条的开销与文件大小无关
+
+// 告警日志中的一条告警
+struct PlaybackAlert {
+    double time;
+    AlertLevel level;
+    std::string text;   // 与实时告警面板相同的完整文本 "[t s] message"
+};
+
+class LogPlayback {
+public:
+    LogPlayback() = default;
+    LogPlayback(const LogPlayback&) = delete;
+    LogPlayback& operator=(const LogPlayback&) = delete;
+
+    // 打开数据日志；告警日志缺失时只回放数据
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // 记录的时间范围
+    double startTime() const;
+    double endTime() const;
+    size_t rowCount() const;
+
+    // 本次打开是否直接使用了已有索引
+    bool indexLoaded() const;
+
+    // time 时刻显示的样本：时间不大于 time 的最后一行（早于首行时取首行）
+    bool sampleAt(double time, Sample& sample) const;
+
+    // 全部告警（按时间排序）与时间不大于 time 的告警个数
+    const std::vector<PlaybackAlert>& alerts() const;
+    size_t alertsUntil(double time) const;
+
+private:
+    bool loadAlerts(const std::string& path);
+
+    TelemetryReader reader;
+    std::vector<PlaybackAlert> alertList;
+};
+
+#endif // LOGPLAYBACK_H
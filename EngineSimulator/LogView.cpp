@@ -0,0 +1,67 @@
+#include "LogView.h"
+#include <QPainter>
+#include <QScrollBar>
+
+// 构造函数
+LogView::LogView(QWidget* parent) : QListView(parent), followTail(true) {
+    setUniformItemSizes(true);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerItem);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setWordWrap(false);
+}
+
+// 设置模型并连接行变化信号
+void LogView::setModel(QAbstractItemModel* newModel) {
+    if (model()) {
+        disconnect(model(), nullptr, this, nullptr);
+    }
+    QListView::setModel(newModel);
+    if (newModel) {
+        connect(newModel, &QAbstractItemModel::rowsAboutToBeInserted, this, &LogView::onRowsAboutToBeInserted);
+        connect(newModel, &QAbstractItemModel::rowsInserted, this, &LogView::onRowsInserted);
+        connect(newModel, &QAbstractItemModel::rowsRemoved, this, &LogView::onRowsRemoved);
+    }
+}
+
+void LogView::setPlaceholderText(const QString& text) {
+    placeholder = text;
+    viewport()->update();
+}
+
+QString LogView::placeholderText() const {
+    return placeholder;
+}
+
+// 滚动条是否在底部
+bool LogView::atBottom() const {
+    const QScrollBar* bar = verticalScrollBar();
+    return bar->value() >= bar->maximum();
+}
+
+void LogView::onRowsAboutToBeInserted() {
+    followTail = atBottom();
+}
+
+void LogView::onRowsInserted() {
+    if (followTail) {
+        scrollToBottom();
+    }
+}
+
+void LogView::onRowsRemoved(const QModelIndex&, int first, int last) {
+    if (first != 0 || atBottom()) return;
+    QScrollBar* bar = verticalScrollBar();
+    bar->setValue(bar->value() - (last - first + 1));
+}
+
+// 没有日志时绘制提示文字
+void LogView::paintEvent(QPaintEvent* event) {
+    QListView::paintEvent(event);
+    if (placeholder.isEmpty() || (model() && model()->rowCount() > 0)) return;
+    QPainter painter(viewport());
+    QColor color = palette().color(QPalette::Text);
+    color.setAlpha(128);
+    painter.setPen(color);
+    painter.drawText(viewport()->rect().adjusted(4, 4, -4, -4), Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap, placeholder);
+}
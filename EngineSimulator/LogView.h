@@ -0,0 +1,40 @@
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <QListView>
+#include <QString>
+
+// 日志视图
+// 行高一致，只布局和绘制可见行；停留在底部时随新行自动滚动，
+// 用户向上翻看时保持当前位置不动，滚回底部后恢复自动滚动
+class LogView : public QListView {
+    Q_OBJECT
+
+public:
+    explicit LogView(QWidget* parent = nullptr);
+
+    void setModel(QAbstractItemModel* model) override;
+
+    // 没有日志时显示的提示文字
+    void setPlaceholderText(const QString& text);
+    QString placeholderText() const;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private slots:
+    // 插入前记录是否停留在底部，插入后据此决定是否滚动
+    void onRowsAboutToBeInserted();
+    void onRowsInserted();
+
+    // 顶部旧行被丢弃时，用户翻看的位置随之上移，内容保持不动
+    void onRowsRemoved(const QModelIndex& parent, int first, int last);
+
+private:
+    bool atBottom() const;
+
+    QString placeholder;
+    bool followTail;
+};
+
+#endif // LOGVIEW_H
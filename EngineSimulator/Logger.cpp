@@ -1,243 +1,220 @@
 #include "Logger.h"
-#include <QDir>
-#include <QDateTime>
-#include <QCoreApplication>
-#include <QDebug>
-#include <QMetaEnum>
-
-// 辅助：判断当前是否处于“启动阶段”（含刚转入停车）
-static bool isInStartingPhase(const SensorData& data) {
-    return (data.phase == EnginePhase::Starting) ||
-        (data.lastPhase == EnginePhase::Starting && data.phase == EnginePhase::Stopping);
+#include "Checkpoint.h"
+#include "DataGenerator.h"
+#include "SpanTrace.h"
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+
+// 辅助：最低置位的位序号
+static unsigned lowestBit(uint32_t value) {
+    unsigned index = 0;
+    while ((value & 1u) == 0) {
+        value >>= 1;
+        ++index;
+    }
+    return index;
 }
 
-// 辅助：判断当前是否处于“稳态”（含刚转入停车）
-static bool isInStablePhase(const SensorData& data) {
-    return (data.phase == EnginePhase::Stable) ||
-        (data.lastPhase == EnginePhase::Stable && data.phase == EnginePhase::Stopping);
+// 辅助：按指定格式输出当前本地时间
+static std::string localTimeString(const char* format) {
+    std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    char buffer[64];
+    std::strftime(buffer, sizeof(buffer), format, &local);
+    return buffer;
 }
 
+// 告警文件流缓冲区大小
+static constexpr size_t ALERT_BUFFER_SIZE = 64 << 10;
+
 // 构造与析构
-Logger::Logger() = default;
+Logger::Logger() : alertBuffer(ALERT_BUFFER_SIZE) {
+    resetAlertDedup();
+}
 Logger::~Logger() {
-    if (dataFile.isOpen()) dataFile.close();
-    if (alertFile.isOpen()) alertFile.close();
+    close();
+}
+
+// 设置日志目录
+void Logger::setLogDirectory(const std::string& dir) {
+    logDirectory = dir;
+}
+
+// 设置数据日志格式
+void Logger::setDataLogFormat(DataLogFormat format) {
+    dataFormat = format;
+}
+
+// 消费一个模拟样本
+void Logger::consume(const Sample& sample) {
+    // 新一次运行开始：建立日志文件，未设置目录时只做告警
+    if (sample.running && !inSession) {
+        inSession = true;
+        if (!resumeAlertDedup) resetAlertDedup();
+        if (!logDirectory.empty()) {
+            initLogFile(logDirectory);
+        }
+        else {
+            isLogging = true;
+        }
+        resumeAlertDedup = false;
+    }
+
+    // 时间步样本：记录数据与告警
+    if (sample.stepped) {
+        StageTimer timer(stats);
+        logDataAndAlerts(sample.time, DataGenerator::processData(sample.data), sample.anomaly, sample.alerts);
+        timer.lap(TickStage::Log);
+    }
+
+    // 运行结束：关闭日志文件
+    if (!sample.running && inSession) {
+        inSession = false;
+        close();
+    }
 }
 
 // 初始化日志文件
-void Logger::initLogFile() {
-	// 重置告警时间记录
-    lastAlertTime.clear();
+bool Logger::initLogFile(const std::string& loggingDir) {
+    close();
+
+	// 重置告警时间记录（从检查点恢复时保留）
+    if (!resumeAlertDedup) resetAlertDedup();
 
 	// 创建 DataLogging 目录
-    QString exePath = QCoreApplication::applicationDirPath();
-    QString loggingDir = exePath + "/DataLogging";
-
-    QDir dir;
-    if (!dir.exists(loggingDir)) {
-        if (!dir.mkpath(loggingDir)) {
-            qWarning() << "Failed to create DataLogging directory!";
-            return;
-        }
+    std::error_code ec;
+    std::filesystem::create_directories(loggingDir, ec);
+    if (ec) {
+        std::cerr << "Failed to create DataLogging directory: " << loggingDir << "\n";
+        return false;
     }
 
-    QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+    std::string timestamp = localTimeString("%Y%m%d_%H%M%S");
     currentBaseName = loggingDir + "/" + timestamp;
 
     // 初始化数据日志 (.csv)
-    dataFile.setFileName(currentBaseName + ".csv");
-    if (!dataFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open data log file:" << currentBaseName + ".csv";
-        return;
+    if (dataFormat != DataLogFormat::Binary) {
+        if (!dataFile.open(currentBaseName + ".csv")) {
+            return false;
+        }
+    }
+
+    // 初始化二进制列式数据日志 (.tlm)
+    if (dataFormat != DataLogFormat::Text) {
+        if (!telemetryFile.open(currentBaseName + ".tlm")) {
+            return false;
+        }
     }
-    dataStream.setDevice(&dataFile);
-    dataStream << "Timestamp(s),N1LeftAverage,N1RightAverage,EGTLeftAverage,EGTRightAverage,FuelLevel,FuelFlow,Phase\n";
-    dataStream.flush();
 
     // 初始化告警日志 (.log)
-    alertFile.setFileName(currentBaseName + ".log");
-    if (!alertFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open alert log file:" << currentBaseName + ".log";
+    alertFile.rdbuf()->pubsetbuf(alertBuffer.data(), static_cast<std::streamsize>(alertBuffer.size()));
+    alertFile.open(currentBaseName + ".log", std::ios::out | std::ios::trunc);
+    if (!alertFile.is_open()) {
+        std::cerr << "Failed to open alert log file: " << currentBaseName << ".log\n";
     }
     else {
-        alertStream.setDevice(&alertFile);
-        alertStream << "=== Engine Simulator Alert Log ===\n";
-        alertStream << "Start Time: " << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n\n";
-        alertStream.flush();
+        alertFile << "=== Engine Simulator Alert Log ===\n";
+        alertFile << "Start Time: " << localTimeString("%Y-%m-%dT%H:%M:%S") << "\n\n";
+        alertFile.flush();
     }
 
     isLogging = true;
-    qDebug() << "Log files created:" << currentBaseName + ".*";
+    return true;
 }
 
-// 统一记录数据 + 检测告警函数
-void Logger::logDataAndAlerts(double t, const SensorData& data,
-    const AnomalyState& anomaly,
-    QTextEdit* alertDisplay) {
-    if (!isLogging) return;
-
-    // 记录传感器数据到 CSV
-    if (dataFile.isOpen()) {
-        // 定义各数据字段的有效性判断函数（内联函数，简洁易维护）
-        bool isValidN1L = !(anomaly.N1LS1Fail && anomaly.N1LS2Fail); // N1是百分比，0-120
-        bool isValidN1R = !(anomaly.N1RS1Fail && anomaly.N1RS2Fail); // N1是百分比，0-120
-        bool isValidEGTL = !(anomaly.EGTLS1Fail && anomaly.EGTLS2Fail); // EGT合理范围20-1200℃
-        bool isValidEGTR = !(anomaly.EGTRS1Fail && anomaly.EGTRS2Fail); // EGT合理范围20-1200℃
-        bool isValidFuelS = !anomaly.FuelSFail; // 燃油传感器故障
-        bool isValidFuelFlow = !anomaly.FFOverSpeed; // 燃油流速超速
-
-        // 逐个字段处理：有效则格式化数值，无效则显示N/A
-        QString timeStr = QString::number(t, 'f', 2);
-        QString n1LeftStr = isValidN1L ? QString::number(data.n1LeftAverage, 'f', 2) : "N/A";
-        QString n1RightStr = isValidN1R ? QString::number(data.n1RightAverage, 'f', 2) : "N/A";
-        QString egtLeftStr = isValidEGTL ? QString::number(data.egtLeftAverage, 'f', 1) : "N/A";
-        QString egtRightStr = isValidEGTR ? QString::number(data.egtRightAverage, 'f', 1) : "N/A";
-        QString fuelLevelStr = QString::number(data.fuelLevel, 'f', 1);
-        QString fuelFlowStr = QString::number(data.fuelFlow, 'f', 1);
-        QString phaseStr = QString::number(static_cast<int>(data.phase));
-
-        // 拼接日志字符串（无效字段会显示N/A）
-        QString log = QString("Time: %1s | N1 Left: %2% | N1 Right: %3% | EGT Left: %4 \u2103 | EGT Right: %5 \u2103 | Fuel Level: %6 lbs | Fuel Flow: %7 lbs/hr | Phase: %8")
-            .arg(timeStr)
-            .arg(n1LeftStr)
-            .arg(n1RightStr)
-            .arg(egtLeftStr)
-            .arg(egtRightStr)
-            .arg(fuelLevelStr)
-            .arg(fuelFlowStr)
-            .arg(phaseStr);
-
-		dataStream << log << "\n";
-    }
-
-    // 告警检测与记录
+// 结束记录并关闭文件
+void Logger::close() {
+    dataFile.close();
+    telemetryFile.close();
+    if (alertFile.is_open()) alertFile.close();
+    isLogging = false;
+}
 
-    // N1 超转
-    if ((data.n1LeftAverage > 120.0 || data.n1RightAverage > 120.0) && anomaly.N1OverSpeedLevel == 2) {
-        triggerAlert(t, AlertLevel::redWarning, "[Red Warning] N1 overspeed level 2: Exceeds 120% N1", alertDisplay);
-    }
-    else if ((data.n1LeftAverage > 105.0 || data.n1RightAverage > 105.0) && anomaly.N1OverSpeedLevel == 1) {
-        triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] N1 overspeed level 1: Exceeds 105% N1", alertDisplay);
-    }
+// 将缓冲区写入磁盘
+void Logger::flush() {
+    TRACE_SPAN("logFlush");
+    dataFile.flush();
+    telemetryFile.flush();
+    if (alertFile.is_open()) alertFile.flush();
+}
 
-    // EGT 超温
-    if (isInStartingPhase(data)) {
-        if (anomaly.EGTOverSpeedLevel == 2) {
-            triggerAlert(t, AlertLevel::redWarning, "[Red Warning] EGT overtemp level 2: Exceeds 100\u2103 during engine start", alertDisplay);
-        }
-        else if (anomaly.EGTOverSpeedLevel == 1) {
-            triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] EGT overtemp level 1: Exceeds 850 \u2103 during engine start", alertDisplay);
-        }
-    }
-    else if (isInStablePhase(data)) {
-        if (anomaly.EGTOverSpeedLevel == 4) {
-            triggerAlert(t, AlertLevel::redWarning, "[Red Warning] EGT overtemp level 4: Exceeds 1100 \u2103 in stable operation", alertDisplay);
-        }
-        else if (anomaly.EGTOverSpeedLevel == 3) {
-            triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] EGT overtemp level 3: Exceeds 950 \u2103 in stable operation", alertDisplay);
-        }
-    }
+// 设置告警回调
+void Logger::setAlertCallback(AlertCallback callback) {
+    alertCallback = std::move(callback);
+}
 
-    // 燃油异常
-    if (anomaly.LowFuel) {
-        triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] Fuel level: Below 1000 lbs", alertDisplay);
-    }
-    if (anomaly.FFOverSpeed) {
-        triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] Fuel flow: Exceeds 50 lbs per second", alertDisplay);
-    }
-    if (anomaly.FuelSFail) {
-        triggerAlert(t, AlertLevel::redWarning, "[Red Warning] Fuel system: Sensor failure", alertDisplay);
-    }
+// 实时性统计
+void Logger::setStats(TickStats* value) {
+    stats = value;
+}
 
-    // N1 传感器故障
-    if (anomaly.N1LS1Fail && anomaly.N1LS2Fail &&
-        anomaly.N1RS1Fail && anomaly.N1RS2Fail) {
-        triggerAlert(t, AlertLevel::redWarning, "[Red Warning] N1 system: Critical failure all sensors failed", alertDisplay);
-    }
-    else {
-        if (anomaly.N1LS1Fail && anomaly.N1LS2Fail) {
-            triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] N1 system: Left engine sensors failed", alertDisplay);
-        }
-        else if (anomaly.N1LS1Fail || anomaly.N1LS2Fail) {
-            triggerAlert(t, AlertLevel::whiteWarning, "[White Warning] N1 system: Left engine single sensor failure", alertDisplay);
-        }
+// 当前日志文件基础名称
+const std::string& Logger::baseName() const {
+    return currentBaseName;
+}
 
-        if (anomaly.N1RS1Fail && anomaly.N1RS2Fail) {
-            triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] N1 system: Right engine sensors failed", alertDisplay);
-        }
-        else if (anomaly.N1RS1Fail || anomaly.N1RS2Fail) {
-            triggerAlert(t, AlertLevel::whiteWarning, "[White Warning] N1 system: Right engine single sensor failure", alertDisplay);
-        }
-    }
+// 统一记录数据 + 检测告警函数
+void Logger::logDataAndAlerts(double t, const SensorData& data,
+    const AnomalyState& anomaly, uint32_t alerts) {
+    if (!isLogging) return;
+    TRACE_SPAN("logDataAndAlerts");
 
-    // EGT 传感器故障
-    if (anomaly.EGTLS1Fail && anomaly.EGTLS2Fail &&
-        anomaly.EGTRS1Fail && anomaly.EGTRS2Fail) {
-        triggerAlert(t, AlertLevel::redWarning, "[Red Warning] EGT system: Critical failure all sensors failed", alertDisplay);
-    }
-    else {
-        if (anomaly.EGTLS1Fail && anomaly.EGTLS2Fail) {
-            triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] EGT system: Left engine sensors failed", alertDisplay);
-        }
-        else if (anomaly.EGTLS1Fail || anomaly.EGTLS2Fail) {
-            triggerAlert(t, AlertLevel::whiteWarning, "[White Warning] EGT system: Left engine single sensor failure", alertDisplay);
-        }
+    // 记录传感器数据到 CSV 和二进制列式日志（全部故障的字段由有效位标记为 N/A）
+    const uint8_t valid = validMask(anomaly);
+    dataFile.appendRow(t, data, valid);
+    telemetryFile.append(t, data, anomaly);
 
-        if (anomaly.EGTRS1Fail && anomaly.EGTRS2Fail) {
-            triggerAlert(t, AlertLevel::amberWarning, "[Amber Warning] EGT system: Right engine sensors failed", alertDisplay);
-        }
-        else if (anomaly.EGTRS1Fail || anomaly.EGTRS2Fail) {
-            triggerAlert(t, AlertLevel::whiteWarning, "[White Warning] EGT system: Right engine single sensor failure", alertDisplay);
-        }
+    // 告警记录：告警位由模拟核心的规则引擎求出，按目录顺序逐个触发
+    for (uint32_t pending = alerts; pending != 0; pending &= pending - 1) {
+        triggerAlert(t, static_cast<AlertId>(lowestBit(pending)));
     }
 }
 
-// 触发单条告警（含去重 + 文件+UI）
-void Logger::triggerAlert(double elapsedTime, AlertLevel level, const QString & alertMessage, QTextEdit * alertDisplay) {
-    QString msg = alertMessage.trimmed();
-    if (msg.isEmpty()) return;
+// 触发单条告警（含去重 + 文件+回调）：去重按编号查表，只有真正触发时才格式化文本
+void Logger::triggerAlert(double elapsedTime, AlertId id) {
+    const AlertInfo& info = alertInfo(id);
+    double& last = lastAlertTime[static_cast<size_t>(id)];
 
-    // 5秒内同消息不重复
-    if (lastAlertTime.contains(msg)) {
-        if (elapsedTime - lastAlertTime[msg] < 5.0) {
-            return;
-        }
+    // 时间窗内同一告警不重复
+    if (elapsedTime - last < info.dedupWindow) {
+        return;
     }
-
-    lastAlertTime[msg] = elapsedTime;
+    last = elapsedTime;
 
     // 生成统一文本
-    QString fullText = QString("[%1s] %2").arg(elapsedTime, 0, 'f', 3).arg(msg);
+    char text[192];
+    std::snprintf(text, sizeof(text), "[%.3fs] %s", elapsedTime, info.message);
 
     // 写入文件
-    if (alertFile.isOpen()) {
-        alertStream << fullText << "\n";
-        alertStream.flush();
+    if (alertFile.is_open()) {
+        alertFile << text << "\n";
     }
 
-    if(alertDisplay){
-        QColor color;
-        switch(level){
-            // 白色警告
-            case AlertLevel::whiteWarning:
-                color = QColor("white");
-                break;
-            // 琥珀色警告
-            case AlertLevel::amberWarning:
-                color = QColor("#FFBF00");
-                break;
-			// 红色警告
-            case AlertLevel::redWarning:
-                color = QColor("red");
-                break;
-        }
-        alertDisplay->setTextColor(color);
-	}
-
-    // 显示到 UI
-    if (alertDisplay) {
-        alertDisplay->append(fullText);
+    // 交给界面或命令行显示
+    if (alertCallback) {
+        alertCallback(elapsedTime, info.level, text);
     }
+}
 
-    qDebug() << "[ALERT]" << fullText;
-}
\ No newline at end of file
+// 检查点：告警去重时间
+void Logger::saveAlertState(CheckpointWriter& writer) const {
+    writer.put(lastAlertTime);
+}
+bool Logger::loadAlertState(CheckpointReader& reader) {
+    if (!reader.get(lastAlertTime)) return false;
+    resumeAlertDedup = !inSession;
+    return true;
+}
+
+// 清空告警去重记录
+void Logger::resetAlertDedup() {
+    lastAlertTime.fill(-std::numeric_limits<double>::infinity());
+}
@@ -2,46 +2,106 @@
 #define LOGGER_H
 
 #include "EngineState.h" 
-#include <QFile>
-#include <QTextStream>
-#include <QDateTime>
-#include <QDir>
-#include <QHash>
-#include <QTextEdit> 
+#include "AlertCatalog.h"
+#include "TelemetryLog.h"
+#include "CsvWriter.h"
+#include "TickStats.h"
+#include <fstream>
+#include <functional>
+#include <string>
+#include <array>
+#include <vector>
+
+// 数据日志格式：文本（.csv）、二进制列式（.tlm）或两者同时写
+enum class DataLogFormat {
+    Text,
+    Binary,
+    Both
+};
+
+class CheckpointWriter;
+class CheckpointReader;
 
 class Logger {
 public:
+    // 告警回调：触发时间、告警级别、完整告警文本
+    using AlertCallback = std::function<void(double, AlertLevel, const std::string&)>;
+
     explicit Logger();
     ~Logger();
 
-    // 初始化日志文件（创建 DataLogging/ 目录和文件）
-    void initLogFile(); 
+    // 设置日志目录（为空则只处理告警，不写文件）
+    void setLogDirectory(const std::string& dir);
+
+    // 设置数据日志格式（下一次建立日志文件时生效）
+    void setDataLogFormat(DataLogFormat format);
+
+    // 初始化日志文件（在 loggingDir 下创建目录和以时间戳命名的文件）
+    bool initLogFile(const std::string& loggingDir);
+
+    // 消费一个模拟样本：运行开始时建立日志文件，逐步记录数据和告警，运行结束时关闭
+    void consume(const Sample& sample);
+
+    // 结束记录并关闭文件
+    void close();
+
+    // 将缓冲区中的数据和告警写入磁盘（组提交）
+    void flush();
 
-    // 统一处理数据记录 + 告警
+    // 设置告警回调（界面显示、命令行输出等）
+    void setAlertCallback(AlertCallback callback);
+
+    // 实时性统计：记录每个时间步样本的记录耗时（在调用 consume 的线程中写入）
+    void setStats(TickStats* stats);
+
+    // 统一处理数据记录 + 告警（alerts 为规则引擎求出的告警位，见 RuleEngine.h）
     void logDataAndAlerts(double t,const SensorData& data,
-        const AnomalyState& anomaly,
-        QTextEdit* alertDisplay = nullptr);
+        const AnomalyState& anomaly, uint32_t alerts);
+
+    // 当前日志文件基础名称（不含扩展名）
+    const std::string& baseName() const;
+
+    // 检查点：告警去重时间。恢复后开始的下一次运行沿用恢复的去重状态，而不是清空
+    void saveAlertState(CheckpointWriter& writer) const;
+    bool loadAlertState(CheckpointReader& reader);
 
 private:
 	// 数据日志文件和告警日志文件
-    QFile dataFile;
-    QFile alertFile; 
+    CsvWriter dataFile;
+    std::ofstream alertFile;
+
+    // 告警文件流缓冲区（大块写入，由 flush() 或关闭时统一落盘）
+    std::vector<char> alertBuffer;
 
-	// 数据流对象
-    QTextStream dataStream;
-    QTextStream alertStream;
+    // 二进制列式数据日志
+    TelemetryWriter telemetryFile;
+    DataLogFormat dataFormat = DataLogFormat::Text;
 
-	// 当前日志文件基础名称
-    QString currentBaseName;
+	// 日志目录和当前日志文件基础名称
+    std::string logDirectory;
+    std::string currentBaseName;
+
+	// 是否处于一次运行中（由样本的运行标志驱动）
+    bool inSession = false;
 
 	// 是否正在记录日志
     bool isLogging = false;
 
-    // 5秒告警去重
-    QHash<QString, double> lastAlertTime; 
+    // 告警去重：按告警编号记录上次触发时间
+    std::array<double, ALERT_COUNT> lastAlertTime;
+    bool resumeAlertDedup = false;
+
+    // 告警回调
+    AlertCallback alertCallback;
+
+    // 实时性统计
+    TickStats* stats = nullptr;
+
+    // 辅助函数：按告警目录触发告警并记录
+    void triggerAlert(double elapsedTime, AlertId id);
 
-    // 辅助函数：生成不同颜色的告警并记录
-    void triggerAlert(double elapsedTime, AlertLevel level, const QString& alertMessage, QTextEdit* alertDisplay);
+    // 清空告警去重记录
+    void resetAlertDedup();
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <random>
+
+// 随机数策略
+// 数据生成器通过模板参数选择随机数发生器，要求：可由 uint64_t 种子构造、提供 seed(uint64_t)，
+// operator() 返回 64 位均匀整数（xoshiro256++、std::mt19937_64 均满足）。
+// 每个生成器实例持有自己的发生器，没有共享状态；相同种子产生逐位相同的序列
+
+// 64 位混合函数（SplitMix64 的输出变换）
+inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// SplitMix64：由单个 64 位种子展开发生器状态
+inline uint64_t splitMix64(uint64_t& state) {
+    return mix64(state += 0x9E3779B97F4A7C15ull);
+}
+
+// 计数器随机数：key 对应的 SplitMix64 序列中的第 counter 个数（从 0 起），可按任意顺序直接取值。
+// 模拟噪声以步数为计数器，任一步的噪声无需生成之前的序列即可得到
+inline uint64_t counterRandom(uint64_t key, uint64_t counter) {
+    return mix64(key + (counter + 1) * 0x9E3779B97F4A7C15ull);
+}
+
+// 由种子和流编号得到计数器随机数的 key，不同流之间互不相关
+inline uint64_t counterStreamKey(uint64_t seed, uint64_t stream) {
+    return mix64(seed ^ mix64(stream + 0x632BE59BD9B4E019ull));
+}
+
+// xoshiro256++（默认策略）：状态 32 字节，周期 2^256 - 1
+class Xoshiro256PlusPlus {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256PlusPlus(uint64_t value = 0) {
+        seed(value);
+    }
+
+    void seed(uint64_t value) {
+        uint64_t sm = value;
+        for (uint64_t& word : s) {
+            word = splitMix64(sm);
+        }
+    }
+
+    result_type operator()() {
+        const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+    static constexpr result_type max() {
+        return UINT64_MAX;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t s[4];
+};
+
+// [0, 1) 区间均匀分布，取高 53 位
+template <typename Rng>
+inline double uniform01(Rng& rng) {
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+// 系统随机种子（未指定种子时使用）
+inline uint64_t randomSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+#endif // RANDOM_H
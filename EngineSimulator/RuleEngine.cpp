@@ -0,0 +1,141 @@
+#include "RuleEngine.h"
+#include <algorithm>
+
+// 阈值规则表
+const ThresholdRule THRESHOLD_RULES[] = {
+    // N1 超转：105% 告警，120% 停车
+    { AnomalySlot::N1OverSpeed, RuleChannel::N1, PhaseScope::Any, Compare::Above, 120.0, 0.0, 2, RuleAction::AutoStop, AlertId::N1OverSpeed2 },
+    { AnomalySlot::N1OverSpeed, RuleChannel::N1, PhaseScope::Any, Compare::Above, 105.0, 0.0, 1, RuleAction::None, AlertId::N1OverSpeed1 },
+    // EGT 超温（启动阶段）：850 告警，1000 停车
+    { AnomalySlot::EGTOverTemp, RuleChannel::EGT, PhaseScope::Starting, Compare::Above, 1000.0, 0.0, 2, RuleAction::AutoStop, AlertId::EGTOverTempStart2 },
+    { AnomalySlot::EGTOverTemp, RuleChannel::EGT, PhaseScope::Starting, Compare::Above, 850.0, 0.0, 1, RuleAction::None, AlertId::EGTOverTempStart1 },
+    // EGT 超温（稳态）：950 告警，1100 停车
+    { AnomalySlot::EGTOverTemp, RuleChannel::EGT, PhaseScope::Stable, Compare::Above, 1100.0, 0.0, 4, RuleAction::AutoStop, AlertId::EGTOverTempStable4 },
+    { AnomalySlot::EGTOverTemp, RuleChannel::EGT, PhaseScope::Stable, Compare::Above, 950.0, 0.0, 3, RuleAction::None, AlertId::EGTOverTempStable3 },
+    // 燃油：余量低于 1000，流速超过 50
+    { AnomalySlot::LowFuel, RuleChannel::FuelLevel, PhaseScope::Any, Compare::Below, 1000.0, 0.0, 1, RuleAction::None, AlertId::LowFuel },
+    { AnomalySlot::FuelFlowOverSpeed, RuleChannel::FuelFlow, PhaseScope::Any, Compare::Above, 50.0, 0.0, 1, RuleAction::None, AlertId::FuelFlowOverSpeed },
+};
+const size_t THRESHOLD_RULE_COUNT = sizeof(THRESHOLD_RULES) / sizeof(THRESHOLD_RULES[0]);
+
+static_assert(ALERT_COUNT <= 32, "alert bits must fit in uint32_t");
+
+namespace {
+
+constexpr size_t SLOT_COUNT = static_cast<size_t>(AnomalySlot::Count);
+
+// 异常状态读写
+int slotLevel(const AnomalyState& anomaly, AnomalySlot slot) {
+    switch (slot) {
+    case AnomalySlot::N1OverSpeed: return anomaly.N1OverSpeedLevel;
+    case AnomalySlot::EGTOverTemp: return anomaly.EGTOverSpeedLevel;
+    case AnomalySlot::FuelFlowOverSpeed: return anomaly.FFOverSpeed ? 1 : 0;
+    case AnomalySlot::LowFuel: return anomaly.LowFuel ? 1 : 0;
+    case AnomalySlot::Count: break;
+    }
+    return 0;
+}
+
+void setSlotLevel(AnomalyState& anomaly, AnomalySlot slot, int level) {
+    switch (slot) {
+    case AnomalySlot::N1OverSpeed: anomaly.N1OverSpeedLevel = level; break;
+    case AnomalySlot::EGTOverTemp: anomaly.EGTOverSpeedLevel = level; break;
+    case AnomalySlot::FuelFlowOverSpeed: anomaly.FFOverSpeed = level != 0; break;
+    case AnomalySlot::LowFuel: anomaly.LowFuel = level != 0; break;
+    case AnomalySlot::Count: break;
+    }
+}
+
+} // namespace
+
+// 两发合并的通道值：取较大值即"任一发越限"
+void fillChannels(const SensorData& data, double (&channels)[static_cast<size_t>(RuleChannel::Count)]) {
+    channels[static_cast<size_t>(RuleChannel::N1)] = std::max(data.n1LeftAverage, data.n1RightAverage);
+    channels[static_cast<size_t>(RuleChannel::EGT)] = std::max(data.egtLeftAverage, data.egtRightAverage);
+    channels[static_cast<size_t>(RuleChannel::FuelFlow)] = data.fuelFlow;
+    channels[static_cast<size_t>(RuleChannel::FuelLevel)] = data.fuelLevel;
+}
+
+// 按规则表求值：第一遍求每个异常状态的新等级，第二遍确定动作和告警
+RuleOutcome evaluateRules(const double* channels, EnginePhase phase, EnginePhase lastPhase, AnomalyState& anomaly) {
+    // 各阶段范围当前是否生效
+    bool scopeActive[static_cast<size_t>(PhaseScope::Count)];
+    scopeActive[static_cast<size_t>(PhaseScope::Any)] = true;
+    scopeActive[static_cast<size_t>(PhaseScope::Starting)] = phase == EnginePhase::Starting ||
+        (lastPhase == EnginePhase::Starting && phase == EnginePhase::Stopping);
+    scopeActive[static_cast<size_t>(PhaseScope::Stable)] = phase == EnginePhase::Stable ||
+        (lastPhase == EnginePhase::Stable && phase == EnginePhase::Stopping);
+
+    int oldLevel[SLOT_COUNT];
+    int newLevel[SLOT_COUNT] = {};
+    bool slotActive[SLOT_COUNT] = {};
+    for (size_t s = 0; s < SLOT_COUNT; ++s) {
+        oldLevel[s] = slotLevel(anomaly, static_cast<AnomalySlot>(s));
+    }
+
+    bool exceeded[sizeof(THRESHOLD_RULES) / sizeof(THRESHOLD_RULES[0])];
+    for (size_t i = 0; i < THRESHOLD_RULE_COUNT; ++i) {
+        const ThresholdRule& rule = THRESHOLD_RULES[i];
+        const size_t s = static_cast<size_t>(rule.slot);
+        const bool active = scopeActive[static_cast<size_t>(rule.phase)];
+        // 已处于该等级及以上时按滞回余量放宽阈值
+        const double margin = oldLevel[s] >= rule.level ? rule.hysteresis : 0.0;
+        const double value = channels[static_cast<size_t>(rule.channel)];
+        const bool over = rule.compare == Compare::Above ? value > rule.threshold - margin
+            : value < rule.threshold + margin;
+        exceeded[i] = active && over;
+        slotActive[s] = slotActive[s] || active;
+        newLevel[s] = std::max(newLevel[s], exceeded[i] ? static_cast<int>(rule.level) : 0);
+    }
+
+    RuleOutcome outcome;
+    for (size_t s = 0; s < SLOT_COUNT; ++s) {
+        if (!slotActive[s] || newLevel[s] == oldLevel[s]) continue;
+        setSlotLevel(anomaly, static_cast<AnomalySlot>(s), newLevel[s]);
+        if (static_cast<AnomalySlot>(s) == AnomalySlot::LowFuel) outcome.sensorChanged = true;
+        else outcome.speedChanged = true;
+    }
+    for (size_t i = 0; i < THRESHOLD_RULE_COUNT; ++i) {
+        const ThresholdRule& rule = THRESHOLD_RULES[i];
+        const size_t s = static_cast<size_t>(rule.slot);
+        if (!exceeded[i] || rule.level != newLevel[s]) continue;
+        outcome.alerts |= alertBit(rule.alert);
+        if (rule.action == RuleAction::AutoStop && oldLevel[s] != newLevel[s]) {
+            outcome.autoStop = true;
+        }
+    }
+    return outcome;
+}
+
+RuleOutcome evaluateRules(const SensorData& data, AnomalyState& anomaly) {
+    double channels[static_cast<size_t>(RuleChannel::Count)];
+    fillChannels(data, channels);
+    return evaluateRules(channels, data.phase, data.lastPhase, anomaly);
+}
+
+// 传感器故障告警：全部故障为红色，单发双传感器为琥珀色，单传感器为白色
+uint32_t sensorAlerts(const AnomalyState& anomaly) {
+    uint32_t alerts = 0;
+    if (anomaly.FuelSFail) alerts |= alertBit(AlertId::FuelSensorFail);
+
+    if (anomaly.N1LS1Fail && anomaly.N1LS2Fail && anomaly.N1RS1Fail && anomaly.N1RS2Fail) {
+        alerts |= alertBit(AlertId::N1AllSensorsFail);
+    }
+    else {
+        if (anomaly.N1LS1Fail && anomaly.N1LS2Fail) alerts |= alertBit(AlertId::N1LeftSensorsFail);
+        else if (anomaly.N1LS1Fail || anomaly.N1LS2Fail) alerts |= alertBit(AlertId::N1LeftSensorFail);
+        if (anomaly.N1RS1Fail && anomaly.N1RS2Fail) alerts |= alertBit(AlertId::N1RightSensorsFail);
+        else if (anomaly.N1RS1Fail || anomaly.N1RS2Fail) alerts |= alertBit(AlertId::N1RightSensorFail);
+    }
+
+    if (anomaly.EGTLS1Fail && anomaly.EGTLS2Fail && anomaly.EGTRS1Fail && anomaly.EGTRS2Fail) {
+        alerts |= alertBit(AlertId::EGTAllSensorsFail);
+    }
+    else {
+        if (anomaly.EGTLS1Fail && anomaly.EGTLS2Fail) alerts |= alertBit(AlertId::EGTLeftSensorsFail);
+        else if (anomaly.EGTLS1Fail || anomaly.EGTLS2Fail) alerts |= alertBit(AlertId::EGTLeftSensorFail);
+        if (anomaly.EGTRS1Fail && anomaly.EGTRS2Fail) alerts |= alertBit(AlertId::EGTRightSensorsFail);
+        else if (anomaly.EGTRS1Fail || anomaly.EGTRS2Fail) alerts |= alertBit(AlertId::EGTRightSensorFail);
+    }
+    return alerts;
+}
@@ -0,0 +1,93 @@
+#ifndef RULEENGINE_H
+#define RULEENGINE_H
+
+#include "EngineState.h"
+#include "AlertCatalog.h"
+#include <cstddef>
+#include <cstdint>
+
+// 阈值规则引擎
+// 超转、超温、燃油流速、低油量的阈值只在规则表中声明一次。模拟核心每步求值一次，
+// 求值结果（异常等级、自动停车、触发的告警）写入样本，界面和日志直接使用，不再各自判断阈值。
+// 规则按通道值求值，通道值由调用方填入，同一张表可用于任意台数发动机
+
+// 规则读取的通道
+enum class RuleChannel {
+    N1,           // 两发 N1 较大值
+    EGT,          // 两发 EGT 较大值
+    FuelFlow,     // 燃油流速
+    FuelLevel,    // 燃油余量
+    Count
+};
+
+// 规则写入的异常状态
+enum class AnomalySlot {
+    N1OverSpeed,      // AnomalyState::N1OverSpeedLevel
+    EGTOverTemp,      // AnomalyState::EGTOverSpeedLevel
+    FuelFlowOverSpeed,// AnomalyState::FFOverSpeed
+    LowFuel,          // AnomalyState::LowFuel
+    Count
+};
+
+// 规则生效的阶段（Starting/Stable 包含由该阶段刚转入的停车阶段）
+enum class PhaseScope : uint8_t {
+    Any,
+    Starting,
+    Stable,
+    Count
+};
+
+// 比较方向
+enum class Compare : uint8_t {
+    Above,   // 值 > 阈值
+    Below    // 值 < 阈值
+};
+
+// 规则触发时的动作
+enum class RuleAction : uint8_t {
+    None,
+    AutoStop   // 进入该等级时停车
+};
+
+// 一条阈值规则
+// 同一异常状态的规则构成等级阶梯：有规则生效时，该状态取所有越限规则中的最高等级（无越限为 0）；
+// 没有规则生效（阶段不符）时保持不变
+struct ThresholdRule {
+    AnomalySlot slot;
+    RuleChannel channel;
+    PhaseScope phase;
+    Compare compare;
+    double threshold;
+    double hysteresis;   // 已处于该等级时，需回到阈值内侧此余量才解除
+    uint8_t level;       // 越限时的异常等级
+    RuleAction action;
+    AlertId alert;       // 处于该等级时的告警
+};
+
+extern const ThresholdRule THRESHOLD_RULES[];
+extern const size_t THRESHOLD_RULE_COUNT;
+
+// 告警位：第 i 位对应 AlertId i
+constexpr uint32_t alertBit(AlertId id) {
+    return 1u << static_cast<unsigned>(id);
+}
+
+// 一次求值的结果
+struct RuleOutcome {
+    uint32_t alerts = 0;        // 阈值规则触发的告警位
+    bool autoStop = false;      // 需要停车
+    bool speedChanged = false;  // 超转/超温/流速状态变化
+    bool sensorChanged = false; // 低油量状态变化
+};
+
+// 取出单台（或两发合并的）通道值
+void fillChannels(const SensorData& data, double (&channels)[static_cast<size_t>(RuleChannel::Count)]);
+
+// 按规则表求值并更新异常状态
+RuleOutcome evaluateRules(const double* channels, EnginePhase phase, EnginePhase lastPhase, AnomalyState& anomaly);
+RuleOutcome evaluateRules(const SensorData& data, AnomalyState& anomaly);
+
+// 传感器故障告警位（由传感器故障状态直接决定）
+uint32_t sensorAlerts(const AnomalyState& anomaly);
+
+#endif // RULEENGINE_H
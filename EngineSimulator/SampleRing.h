@@ -0,0 +1,101 @@
+#ifndef SAMPLERING_H
+#define SAMPLERING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 单生产者单消费者无锁环形缓冲区
+// 生产者（模拟线程）写入从不阻塞：缓冲区满时丢弃新样本并计入溢出计数；
+// 消费者（日志、仪表等）按各自节奏批量读取。每个消费者使用独立的一个缓冲区。
+template <typename T>
+class SampleRing {
+public:
+    // 容量向上取整为 2 的幂
+    explicit SampleRing(size_t capacity = 1024)
+        : mask(roundUpPow2(capacity) - 1), buffer(mask + 1),
+          head(0), cachedTail(0), tail(0), cachedHead(0), overflow(0) {
+    }
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    // 生产者写入一个样本；缓冲区已满时返回 false
+    bool push(const T& item) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - cachedTail > mask) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h - cachedTail > mask) {
+                overflow.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buffer[h & mask] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者读取一个样本；缓冲区为空时返回 false
+    bool pop(T& item) {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t == cachedHead) return false;
+        }
+        item = buffer[t & mask];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者批量读取：对当前可读的样本逐个调用 func（原地访问，不拷贝），返回读取个数
+    template <typename Func>
+    size_t drain(Func&& func, size_t maxItems = SIZE_MAX) {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        cachedHead = head.load(std::memory_order_acquire);
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(cachedHead - t, maxItems));
+        for (size_t i = 0; i < count; ++i) {
+            func(static_cast<const T&>(buffer[(t + i) & mask]));
+        }
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+    // 当前可读样本数（近似值）
+    size_t size() const {
+        return static_cast<size_t>(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+    }
+
+    // 容量
+    size_t capacity() const {
+        return mask + 1;
+    }
+
+    // 因缓冲区满而丢弃的样本数
+    uint64_t overflowCount() const {
+        return overflow.load(std::memory_order_relaxed);
+    }
+
+private:
+    static size_t roundUpPow2(size_t value) {
+        size_t result = 2;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    const size_t mask;
+    std::vector<T> buffer;
+
+    // 生产者侧：写位置和缓存的读位置
+    alignas(64) std::atomic<uint64_t> head;
+    uint64_t cachedTail;
+
+    // 消费者侧：读位置和缓存的写位置
+    alignas(64) std::atomic<uint64_t> tail;
+    uint64_t cachedHead;
+
+    // 溢出计数
+    alignas(64) std::atomic<uint64_t> overflow;
+};
+
+#endif // SAMPLERING_H
@@ -0,0 +1,211 @@
+#include "SimdKernels.h"
+#include "Random.h"
+#include "Log10Table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// CPU 特性检测
+struct CpuFeatures {
+    bool avx2;
+    bool avx512;
+};
+
+CpuFeatures detectCpu() {
+    CpuFeatures features{ false, false };
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || maxLeaf < 7) return features;
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+    __cpuidex(info, 7, 0);
+    features.avx2 = ymmState && (info[1] & (1 << 5)) != 0;
+    features.avx512 = zmmState && (info[1] & (1 << 16)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512 = __builtin_cpu_supports("avx512f");
+#endif
+    features.avx2 = features.avx2 && simd::avx2Compiled();
+    features.avx512 = features.avx512 && simd::avx512Compiled();
+    return features;
+}
+
+const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features = detectCpu();
+    return features;
+}
+
+KernelPath resolve(KernelPath path) {
+    if (path == KernelPath::Auto) return bestKernelPath();
+    return kernelPathAvailable(path) ? path : KernelPath::Scalar;
+}
+
+// 两个浮点数之间相差的 ULP 数
+double ulpDistance(double a, double b) {
+    if (a == b) return 0.0;
+    if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b) ? 0.0 : HUGE_VAL;
+    int64_t ia, ib;
+    std::memcpy(&ia, &a, sizeof(ia));
+    std::memcpy(&ib, &b, sizeof(ib));
+    // 转为单调整数序
+    if (ia < 0) ia = INT64_MIN - ia;
+    if (ib < 0) ib = INT64_MIN - ib;
+    const uint64_t diff = ia > ib ? static_cast<uint64_t>(ia) - static_cast<uint64_t>(ib)
+        : static_cast<uint64_t>(ib) - static_cast<uint64_t>(ia);
+    return static_cast<double>(diff);
+}
+
+} // namespace
+
+// 当前 CPU 支持的最快实现
+KernelPath bestKernelPath() {
+    const CpuFeatures& features = cpuFeatures();
+    if (features.avx512) return KernelPath::Avx512;
+    if (features.avx2) return KernelPath::Avx2;
+    return KernelPath::Scalar;
+}
+
+// 该实现是否可在当前 CPU 上运行
+bool kernelPathAvailable(KernelPath path) {
+    switch (path) {
+    case KernelPath::Scalar:
+    case KernelPath::Auto:
+    case KernelPath::Table:
+        return true;
+    case KernelPath::Avx2:
+        return cpuFeatures().avx2;
+    case KernelPath::Avx512:
+        return cpuFeatures().avx512;
+    }
+    return false;
+}
+
+// 实现名称
+const char* kernelPathName(KernelPath path) {
+    switch (path) {
+    case KernelPath::Scalar: return "scalar";
+    case KernelPath::Avx2: return "avx2";
+    case KernelPath::Avx512: return "avx512";
+    case KernelPath::Auto: return "auto";
+    case KernelPath::Table: return "table";
+    }
+    return "unknown";
+}
+
+// 标量噪声系数：高 52 位拼成 [1, 2) 的双精度数再减 1，与向量实现的运算顺序相同
+double noiseFactor(uint64_t bits) {
+    const uint64_t mantissa = (bits >> 12) | 0x3FF0000000000000ull;
+    double one;
+    std::memcpy(&one, &mantissa, sizeof(one));
+    const double u = one - 1.0;
+    return (1.0 + u * 0.02) - 0.01;
+}
+
+// log10 内核
+void log10Kernel(KernelPath path, const double* in, double* out, size_t count) {
+    switch (resolve(path)) {
+    case KernelPath::Table:
+        simd::log10Table(in, out, count);
+        return;
+    case KernelPath::Avx512:
+        simd::log10Avx512(in, out, count);
+        return;
+    case KernelPath::Avx2:
+        simd::log10Avx2(in, out, count);
+        return;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::log10(in[i]);
+        }
+        return;
+    }
+}
+
+// 噪声内核
+void noiseKernel(KernelPath path, double* values, const uint64_t* bits, size_t count) {
+    switch (resolve(path)) {
+    case KernelPath::Avx512:
+        simd::noiseAvx512(values, bits, count);
+        return;
+    case KernelPath::Avx2:
+        simd::noiseAvx2(values, bits, count);
+        return;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            values[i] *= noiseFactor(bits[i]);
+        }
+        return;
+    }
+}
+
+// 查表 log10
+void simd::log10Table(const double* in, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = ::log10Table(in[i]);
+    }
+}
+
+// 校验结果：查表实现按绝对误差上限判断，其余按 ULP 判断
+bool KernelCheck::passed() const {
+    const bool log10Ok = tabulated ? maxLog10Error <= LOG10_TABLE_ERROR_BOUND : maxLog10Ulp <= LOG10_ULP_BOUND;
+    return log10Ok && noiseExact;
+}
+
+// 校验指定实现
+KernelCheck checkKernel(KernelPath path) {
+    KernelCheck check{ 0.0, 0.0, path == KernelPath::Table, true, 0 };
+    Xoshiro256PlusPlus rng(20240601);
+
+    // 样本：启动曲线参数 [1, 1e4)、停车曲线参数 [0.05, 1e3)、全范围对数均匀分布
+    std::vector<double> inputs;
+    for (int i = 0; i < 200000; ++i) {
+        inputs.push_back(1.0 + uniform01(rng) * 1.0e4);
+        inputs.push_back(0.05 + uniform01(rng) * 1.0e3);
+        inputs.push_back(std::pow(10.0, uniform01(rng) * 600.0 - 300.0));
+    }
+    // 边界值：2 的整数次幂附近和 sqrt(2) 分界附近
+    for (int e = -60; e <= 60; ++e) {
+        const double p = std::ldexp(1.0, e);
+        inputs.push_back(p);
+        inputs.push_back(std::nextafter(p, 0.0));
+        inputs.push_back(std::nextafter(p, HUGE_VAL));
+        inputs.push_back(p * 1.4142135623730951);
+    }
+    check.samples = inputs.size();
+
+    std::vector<double> vectorOut(inputs.size());
+    log10Kernel(path, inputs.data(), vectorOut.data(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const double reference = std::log10(inputs[i]);
+        check.maxLog10Ulp = std::max(check.maxLog10Ulp, ulpDistance(vectorOut[i], reference));
+        check.maxLog10Error = std::max(check.maxLog10Error, std::fabs(vectorOut[i] - reference));
+    }
+
+    // 噪声：与标量实现逐位比较（含非整倍数长度的尾部）
+    const size_t noiseCount = 100003;
+    std::vector<uint64_t> bits(noiseCount);
+    std::vector<double> scalarValues(noiseCount), vectorValues(noiseCount);
+    for (size_t i = 0; i < noiseCount; ++i) {
+        bits[i] = rng();
+        scalarValues[i] = vectorValues[i] = 1.0 + uniform01(rng) * 1000.0;
+    }
+    noiseKernel(KernelPath::Scalar, scalarValues.data(), bits.data(), noiseCount);
+    noiseKernel(path, vectorValues.data(), bits.data(), noiseCount);
+    check.noiseExact = std::memcmp(scalarValues.data(), vectorValues.data(), noiseCount * sizeof(double)) == 0;
+    return check;
+}
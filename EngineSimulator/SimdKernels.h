@@ -0,0 +1,66 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 机队生成器的批量计算内核
+// 每个内核有标量、AVX2、AVX-512 三种实现，运行时按 CPU 支持情况选择。
+// 噪声内核各实现逐位一致；log10 内核的向量实现与标量 std::log10 的误差不超过 LOG10_ULP_BOUND。
+// 另有可选的查表实现（Log10Table.h），log10 为编译期生成的表加线性插值，
+// 绝对误差不超过 LOG10_TABLE_ERROR_BOUND，噪声使用标量实现；不参与自动选择。
+enum class KernelPath {
+    Scalar,
+    Avx2,
+    Avx512,
+    Auto,     // 当前 CPU 支持的最快实现
+    Table     // 查表插值 log10（近似）
+};
+
+// 向量 log10 相对标量 std::log10 的误差上限（ULP）
+constexpr double LOG10_ULP_BOUND = 2.0;
+
+// 当前 CPU 支持的最快实现
+KernelPath bestKernelPath();
+
+// 该实现是否可在当前 CPU 上运行
+bool kernelPathAvailable(KernelPath path);
+
+// 实现名称
+const char* kernelPathName(KernelPath path);
+
+// out[i] = log10(in[i])，in 与 out 可以相同
+void log10Kernel(KernelPath path, const double* in, double* out, size_t count);
+
+// 噪声：values[i] *= 1 + u * 0.02 - 0.01，u 由 bits[i] 的高 52 位得到，分布在 [0, 1)
+void noiseKernel(KernelPath path, double* values, const uint64_t* bits, size_t count);
+
+// 标量噪声系数（各实现共用同一运算顺序）
+double noiseFactor(uint64_t bits);
+
+// 内核校验结果
+struct KernelCheck {
+    double maxLog10Ulp;    // log10 相对 std::log10 的最大误差（ULP）
+    double maxLog10Error;  // log10 相对 std::log10 的最大绝对误差
+    bool tabulated;        // 查表实现：按绝对误差上限判断
+    bool noiseExact;       // 噪声结果与标量实现逐位一致
+    size_t samples;        // 校验样本数
+
+    bool passed() const;
+};
+
+// 在启动/停车曲线的参数范围及全范围随机样本上校验指定实现
+KernelCheck checkKernel(KernelPath path);
+
+// 各指令集实现（仅在对应 CPU 上调用）
+namespace simd {
+void log10Table(const double* in, double* out, size_t count);
+void log10Avx2(const double* in, double* out, size_t count);
+void noiseAvx2(double* values, const uint64_t* bits, size_t count);
+void log10Avx512(const double* in, double* out, size_t count);
+void noiseAvx512(double* values, const uint64_t* bits, size_t count);
+bool avx2Compiled();
+bool avx512Compiled();
+}
+
+#endif // SIMDKERNELS_H
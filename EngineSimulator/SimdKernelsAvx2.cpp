@@ -0,0 +1,128 @@
+#include "SimdKernels.h"
+#include <cfloat>
+#include <cmath>
+
+// AVX2 实现（GCC/Clang 下本文件以 -mavx2 单独编译，只在运行时检测到 AVX2 后调用）
+#if defined(__AVX2__) || (defined(_MSC_VER) && defined(_M_X64))
+#include <immintrin.h>
+
+namespace {
+
+constexpr size_t LANES = 4;
+
+// log10：x = m * 2^e，m 归一到 [sqrt(2)/2, sqrt(2))，ln(m) 用 fdlibm 的有理逼近，
+// 再按 log10(x) = e * log10(2) + ln(m) / ln(10) 合成（log10(2) 拆成高低两部分）
+inline __m256d log10Lanes(__m256d x) {
+    const __m256i bits = _mm256_castpd_si256(x);
+
+    // 指数：把 11 位指数字段拼进 2^52 的尾数后相减，得到精确的双精度整数
+    const __m256i exponentField = _mm256_srli_epi64(bits, 52);
+    __m256d e = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(exponentField, _mm256_set1_epi64x(0x4330000000000000ll))),
+        _mm256_set1_pd(4503599627370496.0 + 1023.0));
+
+    // 尾数：[1, 2)，大于 sqrt(2) 时折半并进位到指数
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+        _mm256_set1_epi64x(0x3FF0000000000000ll)));
+    const __m256d big = _mm256_cmp_pd(m, _mm256_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+    e = _mm256_add_pd(e, _mm256_and_pd(big, _mm256_set1_pd(1.0)));
+
+    const __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    const __m256d hfsq = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+    const __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+    const __m256d z = _mm256_mul_pd(s, s);
+    const __m256d w = _mm256_mul_pd(z, z);
+    const __m256d t1 = _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(3.999999999940941908e-01),
+        _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(2.222219843214978396e-01),
+        _mm256_mul_pd(w, _mm256_set1_pd(1.531383769920937332e-01))))));
+    const __m256d t2 = _mm256_mul_pd(z, _mm256_add_pd(_mm256_set1_pd(6.666666666666735130e-01),
+        _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(2.857142874366239149e-01),
+        _mm256_mul_pd(w, _mm256_add_pd(_mm256_set1_pd(1.818357216161805012e-01),
+        _mm256_mul_pd(w, _mm256_set1_pd(1.479819860511658591e-01))))))));
+    const __m256d r = _mm256_add_pd(t2, t1);
+    const __m256d lnm = _mm256_sub_pd(f, _mm256_sub_pd(hfsq, _mm256_mul_pd(s, _mm256_add_pd(hfsq, r))));
+
+    const __m256d low = _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(3.69423907715893078616e-13)),
+        _mm256_mul_pd(lnm, _mm256_set1_pd(4.34294481903251816668e-01)));
+    return _mm256_add_pd(_mm256_mul_pd(e, _mm256_set1_pd(3.01029995663611771306e-01)), low);
+}
+
+// 一组 4 个数：全部为正规正数时走向量路径，否则逐个调用 std::log10
+inline void log10Block(const double* in, double* out) {
+    const __m256d x = _mm256_loadu_pd(in);
+    const __m256d normal = _mm256_and_pd(
+        _mm256_cmp_pd(x, _mm256_set1_pd(DBL_MIN), _CMP_GE_OQ),
+        _mm256_cmp_pd(x, _mm256_set1_pd(DBL_MAX), _CMP_LE_OQ));
+    if (_mm256_movemask_pd(normal) == 0xF) {
+        _mm256_storeu_pd(out, log10Lanes(x));
+    }
+    else {
+        for (size_t i = 0; i < LANES; ++i) {
+            out[i] = std::log10(in[i]);
+        }
+    }
+}
+
+} // namespace
+
+namespace simd {
+
+bool avx2Compiled() {
+    return true;
+}
+
+void log10Avx2(const double* in, double* out, size_t count) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        log10Block(in + i, out + i);
+    }
+    // 尾部补 1.0 凑满一组，保证同一输入的结果与位置无关
+    if (i < count) {
+        double buffer[LANES] = { 1.0, 1.0, 1.0, 1.0 };
+        for (size_t j = 0; j < count - i; ++j) buffer[j] = in[i + j];
+        log10Block(buffer, buffer);
+        for (size_t j = 0; j < count - i; ++j) out[i + j] = buffer[j];
+    }
+}
+
+void noiseAvx2(double* values, const uint64_t* bits, size_t count) {
+    const __m256i exponentOne = _mm256_set1_epi64x(0x3FF0000000000000ll);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d scale = _mm256_set1_pd(0.02);
+    const __m256d offset = _mm256_set1_pd(0.01);
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i));
+        const __m256d u = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(raw, 12), exponentOne)), one);
+        const __m256d factor = _mm256_sub_pd(_mm256_add_pd(one, _mm256_mul_pd(u, scale)), offset);
+        _mm256_storeu_pd(values + i, _mm256_mul_pd(_mm256_loadu_pd(values + i), factor));
+    }
+    for (; i < count; ++i) {
+        values[i] *= noiseFactor(bits[i]);
+    }
+}
+
+} // namespace simd
+
+#else
+
+// 非 x86-64 平台：不提供 AVX2 实现
+namespace simd {
+
+bool avx2Compiled() {
+    return false;
+}
+
+void log10Avx2(const double* in, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = std::log10(in[i]);
+}
+
+void noiseAvx2(double* values, const uint64_t* bits, size_t count) {
+    for (size_t i = 0; i < count; ++i) values[i] *= noiseFactor(bits[i]);
+}
+
+} // namespace simd
+
+#endif
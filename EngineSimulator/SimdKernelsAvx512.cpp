@@ -0,0 +1,131 @@
+#include "SimdKernels.h"
+#include <cfloat>
+#include <cmath>
+
+// AVX-512 实现（GCC/Clang 下本文件以 -mavx512f 单独编译，只在运行时检测到 AVX-512F 后调用）
+#if defined(__AVX512F__) || (defined(_MSC_VER) && defined(_M_X64))
+#include <immintrin.h>
+
+namespace {
+
+constexpr size_t LANES = 8;
+
+// 64 位逻辑右移：用全掩码的 maskz 形式，结果与 _mm512_srli_epi64 相同；
+// 后者在 GCC 12 中经过 _mm512_undefined_epi32，Release 下会报 -Wmaybe-uninitialized
+template <unsigned int Count>
+inline __m512i shiftRight64(__m512i x) {
+    return _mm512_maskz_srli_epi64(0xFF, x, Count);
+}
+
+// log10：算法与 AVX2 实现相同，尾数归一和指数进位改用掩码运算
+inline __m512d log10Lanes(__m512d x) {
+    const __m512i bits = _mm512_castpd_si512(x);
+
+    const __m512i exponentField = shiftRight64<52>(bits);
+    __m512d e = _mm512_sub_pd(
+        _mm512_castsi512_pd(_mm512_or_si512(exponentField, _mm512_set1_epi64(0x4330000000000000ll))),
+        _mm512_set1_pd(4503599627370496.0 + 1023.0));
+
+    __m512d m = _mm512_castsi512_pd(_mm512_or_si512(
+        _mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFll)),
+        _mm512_set1_epi64(0x3FF0000000000000ll)));
+    const __mmask8 big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, big, m, _mm512_set1_pd(0.5));
+    e = _mm512_mask_add_pd(e, big, e, _mm512_set1_pd(1.0));
+
+    const __m512d f = _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+    const __m512d hfsq = _mm512_mul_pd(_mm512_set1_pd(0.5), _mm512_mul_pd(f, f));
+    const __m512d s = _mm512_div_pd(f, _mm512_add_pd(_mm512_set1_pd(2.0), f));
+    const __m512d z = _mm512_mul_pd(s, s);
+    const __m512d w = _mm512_mul_pd(z, z);
+    const __m512d t1 = _mm512_mul_pd(w, _mm512_add_pd(_mm512_set1_pd(3.999999999940941908e-01),
+        _mm512_mul_pd(w, _mm512_add_pd(_mm512_set1_pd(2.222219843214978396e-01),
+        _mm512_mul_pd(w, _mm512_set1_pd(1.531383769920937332e-01))))));
+    const __m512d t2 = _mm512_mul_pd(z, _mm512_add_pd(_mm512_set1_pd(6.666666666666735130e-01),
+        _mm512_mul_pd(w, _mm512_add_pd(_mm512_set1_pd(2.857142874366239149e-01),
+        _mm512_mul_pd(w, _mm512_add_pd(_mm512_set1_pd(1.818357216161805012e-01),
+        _mm512_mul_pd(w, _mm512_set1_pd(1.479819860511658591e-01))))))));
+    const __m512d r = _mm512_add_pd(t2, t1);
+    const __m512d lnm = _mm512_sub_pd(f, _mm512_sub_pd(hfsq, _mm512_mul_pd(s, _mm512_add_pd(hfsq, r))));
+
+    const __m512d low = _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(3.69423907715893078616e-13)),
+        _mm512_mul_pd(lnm, _mm512_set1_pd(4.34294481903251816668e-01)));
+    return _mm512_add_pd(_mm512_mul_pd(e, _mm512_set1_pd(3.01029995663611771306e-01)), low);
+}
+
+// 一组 8 个数：全部为正规正数时走向量路径，否则逐个调用 std::log10
+inline void log10Block(const double* in, double* out) {
+    const __m512d x = _mm512_loadu_pd(in);
+    const __mmask8 normal = _mm512_cmp_pd_mask(x, _mm512_set1_pd(DBL_MIN), _CMP_GE_OQ)
+        & _mm512_cmp_pd_mask(x, _mm512_set1_pd(DBL_MAX), _CMP_LE_OQ);
+    if (normal == 0xFF) {
+        _mm512_storeu_pd(out, log10Lanes(x));
+    }
+    else {
+        for (size_t i = 0; i < LANES; ++i) {
+            out[i] = std::log10(in[i]);
+        }
+    }
+}
+
+} // namespace
+
+namespace simd {
+
+bool avx512Compiled() {
+    return true;
+}
+
+void log10Avx512(const double* in, double* out, size_t count) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        log10Block(in + i, out + i);
+    }
+    // 尾部补 1.0 凑满一组，保证同一输入的结果与位置无关
+    if (i < count) {
+        double buffer[LANES] = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+        for (size_t j = 0; j < count - i; ++j) buffer[j] = in[i + j];
+        log10Block(buffer, buffer);
+        for (size_t j = 0; j < count - i; ++j) out[i + j] = buffer[j];
+    }
+}
+
+void noiseAvx512(double* values, const uint64_t* bits, size_t count) {
+    const __m512i exponentOne = _mm512_set1_epi64(0x3FF0000000000000ll);
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d scale = _mm512_set1_pd(0.02);
+    const __m512d offset = _mm512_set1_pd(0.01);
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m512i raw = _mm512_loadu_si512(bits + i);
+        const __m512d u = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(shiftRight64<12>(raw), exponentOne)), one);
+        const __m512d factor = _mm512_sub_pd(_mm512_add_pd(one, _mm512_mul_pd(u, scale)), offset);
+        _mm512_storeu_pd(values + i, _mm512_mul_pd(_mm512_loadu_pd(values + i), factor));
+    }
+    for (; i < count; ++i) {
+        values[i] *= noiseFactor(bits[i]);
+    }
+}
+
+} // namespace simd
+
+#else
+
+// 非 x86-64 平台：不提供 AVX-512 实现
+namespace simd {
+
+bool avx512Compiled() {
+    return false;
+}
+
+void log10Avx512(const double* in, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = std::log10(in[i]);
+}
+
+void noiseAvx512(double* values, const uint64_t* bits, size_t count) {
+    for (size_t i = 0; i < count; ++i) values[i] *= noiseFactor(bits[i]);
+}
+
+} // namespace simd
+
+#endif
@@ -0,0 +1,556 @@
+#include "Simulation.h"
+#include "RuleEngine.h"
+#include "Checkpoint.h"
+#include "SpanTrace.h"
+#include <algorithm>
+#include <utility>
+
+// 指令名称表，顺序与 Command 枚举一致
+static const char* const COMMAND_NAMES[] = {
+    "Start",
+    "Stop",
+    "IncreaseThrust",
+    "DecreaseThrust",
+    "N1LS1Fail",
+    "N1RS1Fail",
+    "N1LS2Fail",
+    "N1RS2Fail",
+    "EGTLS1Fail",
+    "EGTRS1Fail",
+    "EGTLS2Fail",
+    "EGTRS2Fail",
+    "N1SFail",
+    "EGTSFail",
+    "FuelSFail",
+    "N1OverSpeed1",
+    "N1OverSpeed2",
+    "EGTOverSpeed1",
+    "EGTOverSpeed2",
+    "EGTOverSpeed3",
+    "EGTOverSpeed4",
+    "FFOverSpeed",
+    "LowFuel"
+};
+static_assert(sizeof(COMMAND_NAMES) / sizeof(COMMAND_NAMES[0]) == static_cast<size_t>(Command::Count),
+    "COMMAND_NAMES must match Command");
+
+// 快进时上下界二分失败后每次逐步求值的最多步数，整段规则结果都不变时重新二分
+static constexpr uint64_t SEEK_SCAN_WINDOW = 256;
+
+const char* commandName(Command command) {
+    size_t index = static_cast<size_t>(command);
+    if (index >= static_cast<size_t>(Command::Count)) return "Unknown";
+    return COMMAND_NAMES[index];
+}
+
+bool commandFromName(const std::string& name, Command& command) {
+    for (size_t i = 0; i < static_cast<size_t>(Command::Count); ++i) {
+        if (name == COMMAND_NAMES[i]) {
+            command = static_cast<Command>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// 辅助：N1/EGT 传感器是否全部故障
+static bool allN1Failed(const AnomalyState& anomaly) {
+    return anomaly.N1LS1Fail && anomaly.N1LS2Fail && anomaly.N1RS1Fail && anomaly.N1RS2Fail;
+}
+static bool allEGTFailed(const AnomalyState& anomaly) {
+    return anomaly.EGTLS1Fail && anomaly.EGTLS2Fail && anomaly.EGTRS1Fail && anomaly.EGTRS2Fail;
+}
+
+// 构造函数
+Simulation::Simulation()
+    : currentAlerts(0), stats(nullptr), globalTime(0.0), tickCount(0), stepCounter(0), running(false) {
+}
+
+// 随机种子
+void Simulation::setSeed(uint64_t value) {
+    dataGenerator.seed(value);
+}
+uint64_t Simulation::seed() const {
+    return dataGenerator.seedValue();
+}
+
+// 重置全部模拟状态
+void Simulation::reset(uint64_t value) {
+    dataGenerator = DataGenerator(value);
+    currentData = SensorData();
+    anomalyState = AnomalyState();
+    currentAlerts = 0;
+    globalTime = 0.0;
+    tickCount = 0;
+    stepCounter = 0;
+    running = false;
+}
+
+// 保存模拟状态
+void Simulation::saveState(CheckpointWriter& writer) const {
+    writer.put(currentData);
+    writer.put(anomalyState);
+    writer.put(currentAlerts);
+    writer.put(globalTime);
+    writer.put(tickCount);
+    writer.put(stepCounter);
+    writer.put(static_cast<uint8_t>(running ? 1 : 0));
+    dataGenerator.saveState(writer);
+}
+
+// 恢复模拟状态，并向消费者发布恢复后的状态
+bool Simulation::loadState(CheckpointReader& reader) {
+    uint8_t runningFlag = 0;
+    if (!reader.get(currentData) || !reader.get(anomalyState) || !reader.get(currentAlerts)
+        || !reader.get(globalTime) || !reader.get(tickCount) || !reader.get(stepCounter)
+        || !reader.get(runningFlag) || !dataGenerator.loadState(reader)) {
+        return false;
+    }
+    running = runningFlag != 0;
+    publish(false);
+    return true;
+}
+
+// 指令回调
+void Simulation::setCommandCallback(CommandCallback callback) {
+    commandCallback = std::move(callback);
+}
+
+// 实时性统计
+void Simulation::setStats(TickStats* value) {
+    stats = value;
+}
+
+// 注册样本消费者
+void Simulation::addConsumer(SampleRing<Sample>* ring) {
+    if (std::find(consumers.begin(), consumers.end(), ring) == consumers.end()) {
+        consumers.push_back(ring);
+    }
+}
+
+// 注销样本消费者
+void Simulation::removeConsumer(SampleRing<Sample>* ring) {
+    consumers.erase(std::remove(consumers.begin(), consumers.end(), ring), consumers.end());
+}
+
+// 将当前状态发布给所有消费者，缓冲区满的消费者丢弃该样本
+void Simulation::publish(bool stepped) {
+    if (consumers.empty()) return;
+    TRACE_SPAN("publish");
+    Sample sample;
+    sample.tick = tickCount;
+    sample.time = globalTime;
+    sample.stepped = stepped;
+    sample.running = running;
+    sample.data = currentData;
+    sample.anomaly = anomalyState;
+    sample.alerts = stepped ? currentAlerts : 0;
+    for (SampleRing<Sample>* ring : consumers) {
+        ring->push(sample);
+    }
+}
+
+// 执行一条操作指令
+StepResult Simulation::apply(Command command) {
+    StepResult result;
+    if (commandCallback) commandCallback(stepCounter, command);
+
+    switch (command) {
+    // 启动：传感器全部故障时不允许启动
+    case Command::Start:
+        if (!running && !allN1Failed(anomalyState) && !allEGTFailed(anomalyState)) {
+            dataGenerator.startSequence();
+            globalTime = 0.0;
+            tickCount = 0;
+            running = true;
+        }
+        break;
+
+    // 停车 - 最高优先级
+    case Command::Stop:
+        dataGenerator.stopSequence();
+        break;
+
+    // 推力控制只在稳态有效
+    case Command::IncreaseThrust:
+        if (currentData.phase == EnginePhase::Stable) {
+            dataGenerator.setIncreaseThrust(true);
+        }
+        break;
+    case Command::DecreaseThrust:
+        if (currentData.phase == EnginePhase::Stable) {
+            dataGenerator.setDecreaseThrust(true);
+        }
+        break;
+
+    // 单个传感器故障切换
+    case Command::N1LS1Fail:
+        anomalyState.N1LS1Fail = !anomalyState.N1LS1Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::N1RS1Fail:
+        anomalyState.N1RS1Fail = !anomalyState.N1RS1Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::N1LS2Fail:
+        anomalyState.N1LS2Fail = !anomalyState.N1LS2Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::N1RS2Fail:
+        anomalyState.N1RS2Fail = !anomalyState.N1RS2Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::EGTLS1Fail:
+        anomalyState.EGTLS1Fail = !anomalyState.EGTLS1Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::EGTRS1Fail:
+        anomalyState.EGTRS1Fail = !anomalyState.EGTRS1Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::EGTLS2Fail:
+        anomalyState.EGTLS2Fail = !anomalyState.EGTLS2Fail;
+        result.sensorChanged = true;
+        break;
+    case Command::EGTRS2Fail:
+        anomalyState.EGTRS2Fail = !anomalyState.EGTRS2Fail;
+        result.sensorChanged = true;
+        break;
+
+    // N1/EGT 传感器整体故障切换
+    case Command::N1SFail: {
+        bool fail = !allN1Failed(anomalyState);
+        anomalyState.N1LS1Fail = anomalyState.N1RS1Fail = fail;
+        anomalyState.N1LS2Fail = anomalyState.N1RS2Fail = fail;
+        result.sensorChanged = true;
+        break;
+    }
+    case Command::EGTSFail: {
+        bool fail = !allEGTFailed(anomalyState);
+        anomalyState.EGTLS1Fail = anomalyState.EGTRS1Fail = fail;
+        anomalyState.EGTLS2Fail = anomalyState.EGTRS2Fail = fail;
+        result.sensorChanged = true;
+        break;
+    }
+    case Command::FuelSFail:
+        anomalyState.FuelSFail = !anomalyState.FuelSFail;
+        result.sensorChanged = true;
+        break;
+
+    // N1超转1
+    case Command::N1OverSpeed1:
+        if (currentData.phase != EnginePhase::Stopping && currentData.phase != EnginePhase::Idle) {
+            if (anomalyState.N1OverSpeedLevel == 1) {
+                anomalyState.N1OverSpeedLevel = 0;
+                currentData.n1LeftAverage = currentData.n1RightAverage = 100.0;
+            }
+            else {
+                anomalyState.N1OverSpeedLevel = 1;
+                currentData.n1LeftAverage = currentData.n1RightAverage = 110.0;
+            }
+            currentData.phase = EnginePhase::Stable;
+            dataGenerator.updateData(currentData);
+        }
+        result.speedChanged = true;
+        break;
+
+    // N1超转2，触发停车
+    case Command::N1OverSpeed2:
+        if (currentData.phase != EnginePhase::Stopping && currentData.phase != EnginePhase::Idle) {
+            if (anomalyState.N1OverSpeedLevel != 2) {
+                anomalyState.N1OverSpeedLevel = 2;
+                currentData.n1LeftAverage = currentData.n1RightAverage = 124.0;
+                dataGenerator.updateData(currentData);
+                dataGenerator.stopSequence();
+            }
+        }
+        result.speedChanged = true;
+        break;
+
+    // EGT超温1和2只能在启动阶段触发
+    case Command::EGTOverSpeed1:
+        if (currentData.phase == EnginePhase::Starting) {
+            if (anomalyState.EGTOverSpeedLevel == 1) {
+                anomalyState.EGTOverSpeedLevel = 0;
+                currentData.EGTOverSpeed1 = false;
+            }
+            else {
+                anomalyState.EGTOverSpeedLevel = 1;
+                currentData.EGTOverSpeed1 = true;
+            }
+            dataGenerator.updateData(currentData);
+        }
+        result.speedChanged = true;
+        break;
+    case Command::EGTOverSpeed2:
+        if (currentData.phase == EnginePhase::Starting) {
+            if (anomalyState.EGTOverSpeedLevel != 2) {
+                anomalyState.EGTOverSpeedLevel = 2;
+                currentData.egtLeftAverage = currentData.egtRightAverage = 1100.0;
+                dataGenerator.updateData(currentData);
+                dataGenerator.stopSequence();
+            }
+        }
+        result.speedChanged = true;
+        break;
+
+    // EGT超温3和4只能在稳定阶段触发
+    case Command::EGTOverSpeed3:
+        if (currentData.phase == EnginePhase::Stable) {
+            if (anomalyState.EGTOverSpeedLevel == 3) {
+                anomalyState.EGTOverSpeedLevel = 0;
+                currentData.egtLeftAverage = currentData.egtRightAverage = 720.0;
+            }
+            else {
+                anomalyState.EGTOverSpeedLevel = 3;
+                currentData.egtLeftAverage = currentData.egtRightAverage = 1000.0;
+            }
+            dataGenerator.updateData(currentData);
+        }
+        result.speedChanged = true;
+        break;
+    case Command::EGTOverSpeed4:
+        if (currentData.phase == EnginePhase::Stable) {
+            if (anomalyState.EGTOverSpeedLevel != 4) {
+                anomalyState.EGTOverSpeedLevel = 4;
+                currentData.egtLeftAverage = currentData.egtRightAverage = 1170.0;
+                dataGenerator.updateData(currentData);
+                dataGenerator.stopSequence();
+            }
+        }
+        result.speedChanged = true;
+        break;
+
+    // 燃油流速超速切换
+    case Command::FFOverSpeed:
+        if (currentData.phase == EnginePhase::Stable) {
+            if (anomalyState.FFOverSpeed) {
+                anomalyState.FFOverSpeed = false;
+                currentData.fuelFlow = 40.0;
+            }
+            else {
+                anomalyState.FFOverSpeed = true;
+                currentData.fuelFlow = 60.0; // 设置为高燃油流速状态
+            }
+            dataGenerator.updateData(currentData);
+        }
+        result.speedChanged = true;
+        break;
+
+    // 低燃油状态切换
+    case Command::LowFuel:
+        if (anomalyState.LowFuel) {
+            anomalyState.LowFuel = false;
+            currentData.fuelLevel += 19001.0; // 恢复正常燃油状态
+        }
+        else {
+            anomalyState.LowFuel = true;
+            currentData.fuelLevel -= 19001.0; // 设置为低燃油状态
+        }
+        dataGenerator.updateData(currentData);
+        result.sensorChanged = true;
+        break;
+
+    case Command::Count:
+        break;
+    }
+
+    if (result.sensorChanged) checkSensorFailure();
+    publish(false);
+    return result;
+}
+
+// 推进一个时间步长
+StepResult Simulation::step() {
+    StepResult result;
+    if (!running) return result;
+
+    // 全局时间更新（由步数算出，快进后与逐步推进一致）
+    ++tickCount;
+    ++stepCounter;
+    globalTime = static_cast<double>(tickCount) * TIME_STEP;
+
+    // 数据更新
+    StageTimer timer(stats);
+    dataGenerator.updateData();
+    currentData = dataGenerator.getData();
+    timer.lap(TickStage::Generate);
+
+    // 检查数据异常
+    checkData(result);
+    timer.lap(TickStage::Check);
+
+    // 停车完成后结束本次模拟
+    bool finished = currentData.phase == EnginePhase::Idle;
+    if (finished) running = false;
+
+    // 发布给日志、界面等消费者（日志需要看到复位前的异常状态）
+    publish(true);
+    timer.lap(TickStage::Publish);
+
+    if (finished) {
+        initAnomalyState();
+        result.finished = true;
+        result.speedChanged = true;
+        publish(false);
+    }
+    return result;
+}
+
+// 快进：稳态中跳过规则结果不变的步，启动和停车阶段（各约 10 秒以内）逐步推进
+bool Simulation::seek(uint64_t tick) {
+    if (!running || tick <= tickCount) return false;
+    std::vector<SampleRing<Sample>*> saved;
+    saved.swap(consumers);
+    // 上下界二分失败（噪声跨过门限）时改为逐步求值，逐步求值一整段都不变时再回到二分
+    bool searchSpans = true;
+    while (running && tickCount < tick) {
+        if (currentData.phase == EnginePhase::Stable && tick > tickCount + 1) {
+            uint64_t last = tickCount;
+            if (searchSpans && rulesSteadyUntil(tickCount + 1)) {
+                // 二分查找规则结果保持不变的最远一步（燃油余量单调下降，区间越短越不会越过门限）
+                uint64_t high = tick - 1;
+                last = tickCount + 1;
+                while (last < high) {
+                    const uint64_t mid = last + (high - last + 1) / 2;
+                    if (rulesSteadyUntil(mid)) last = mid;
+                    else high = mid - 1;
+                }
+            }
+            else {
+                const uint64_t limit = std::min(tick - 1, tickCount + SEEK_SCAN_WINDOW);
+                last = rulesSteadyScan(limit);
+                searchSpans = last == limit;
+            }
+            // 跳到规则结果改变的前一步（最多到目标的前一步），改变的那一步正常推进
+            const uint64_t skip = last - tickCount;
+            if (skip > 0) {
+                dataGenerator.advance(skip);
+                tickCount += skip;
+                stepCounter += skip;
+            }
+        }
+        step();
+    }
+    consumers.swap(saved);
+    publish(false);
+    return true;
+}
+
+// 稳态区间内规则结果是否不变：每条规则只比较一个通道且单调，
+// 各通道取区间内的上下界（保持值乘噪声范围、燃油余量的首末值）求值，两端都不改变异常状态即整个区间不变
+bool Simulation::rulesSteadyUntil(uint64_t tick) const {
+    const BasicFleetGenerator<Xoshiro256PlusPlus>& fleet = dataGenerator.fleetGenerator();
+    const uint8_t stable = static_cast<uint8_t>(EnginePhase::Stable);
+    if (fleet.phase()[0] != stable || fleet.phase()[1] != stable || fleet.thrustPending()) return false;
+
+    // 噪声系数在 [0.99, 1.01) 内，放宽一点作为界
+    auto bounds = [](double value, double& low, double& high) {
+        low = std::min(value * 0.989, value * 1.011);
+        high = std::max(value * 0.989, value * 1.011);
+    };
+    double low[static_cast<size_t>(RuleChannel::Count)];
+    double high[static_cast<size_t>(RuleChannel::Count)];
+    double n1Low[2], n1High[2], egtLow[2], egtHigh[2];
+    for (size_t i = 0; i < 2; ++i) {
+        bounds(fleet.holdN1()[i], n1Low[i], n1High[i]);
+        bounds(fleet.holdEgt()[i], egtLow[i], egtHigh[i]);
+    }
+    low[static_cast<size_t>(RuleChannel::N1)] = std::max(n1Low[0], n1Low[1]);
+    high[static_cast<size_t>(RuleChannel::N1)] = std::max(n1High[0], n1High[1]);
+    low[static_cast<size_t>(RuleChannel::EGT)] = std::max(egtLow[0], egtLow[1]);
+    high[static_cast<size_t>(RuleChannel::EGT)] = std::max(egtHigh[0], egtHigh[1]);
+    const double flow = fleet.holdFuelFlow()[0];
+    bounds(flow, low[static_cast<size_t>(RuleChannel::FuelFlow)], high[static_cast<size_t>(RuleChannel::FuelFlow)]);
+
+    // 燃油余量按保持流速线性变化，区间内的取值在当前值和末步值之间
+    const double fuelNow = currentData.fuelLevel;
+    const double fuelEnd = fuelNow - flow * static_cast<double>(tick - tickCount) * TIME_STEP;
+    low[static_cast<size_t>(RuleChannel::FuelLevel)] = std::min(fuelNow, fuelEnd) - 1.0;
+    high[static_cast<size_t>(RuleChannel::FuelLevel)] = std::max(fuelNow, fuelEnd) + 1.0;
+
+    AnomalyState lowState = anomalyState;
+    AnomalyState highState = anomalyState;
+    const RuleOutcome lowOutcome = evaluateRules(low, currentData.phase, currentData.lastPhase, lowState);
+    const RuleOutcome highOutcome = evaluateRules(high, currentData.phase, currentData.lastPhase, highState);
+    return lowState == anomalyState && highState == anomalyState
+        && !lowOutcome.autoStop && !highOutcome.autoStop;
+}
+
+// 噪声由种子和步数直接求出，每步只算通道值和规则，不推进发生器
+uint64_t Simulation::rulesSteadyScan(uint64_t tick) const {
+    const BasicFleetGenerator<Xoshiro256PlusPlus>& fleet = dataGenerator.fleetGenerator();
+    const uint8_t stable = static_cast<uint8_t>(EnginePhase::Stable);
+    if (fleet.phase()[0] != stable || fleet.phase()[1] != stable || fleet.thrustPending()) return tickCount;
+
+    double channels[static_cast<size_t>(RuleChannel::Count)];
+    double n1[2], egt[2], flow[2], fuel[2];
+    for (uint64_t k = tickCount + 1; k <= tick; ++k) {
+        for (size_t i = 0; i < 2; ++i) {
+            fleet.stableSample(i, k, n1[i], egt[i], flow[i], fuel[i]);
+        }
+        // 与 fillChannels() 相同：N1、EGT 取两发较大值，燃油取左发
+        channels[static_cast<size_t>(RuleChannel::N1)] = std::max(n1[0], n1[1]);
+        channels[static_cast<size_t>(RuleChannel::EGT)] = std::max(egt[0], egt[1]);
+        channels[static_cast<size_t>(RuleChannel::FuelFlow)] = flow[0];
+        channels[static_cast<size_t>(RuleChannel::FuelLevel)] = fuel[0];
+        AnomalyState state = anomalyState;
+        const RuleOutcome outcome = evaluateRules(channels, currentData.phase, currentData.lastPhase, state);
+        if (state != anomalyState || outcome.autoStop) return k - 1;
+    }
+    return tick;
+}
+
+// 数据异常检查函数：阈值规则表求值一次，结果同时供界面（异常状态）和日志（告警位）使用
+void Simulation::checkData(StepResult& result) {
+    TRACE_SPAN("checkData");
+    RuleOutcome outcome = evaluateRules(currentData, anomalyState);
+    if (outcome.autoStop) {
+        dataGenerator.stopSequence();
+    }
+    result.speedChanged = result.speedChanged || outcome.speedChanged;
+    result.sensorChanged = result.sensorChanged || outcome.sensorChanged;
+    currentAlerts = outcome.alerts | sensorAlerts(anomalyState);
+
+    if (result.sensorChanged) checkSensorFailure();
+}
+
+// 红色警告（N1 或 EGT 传感器全部故障）直接停车
+void Simulation::checkSensorFailure() {
+    if (allN1Failed(anomalyState) || allEGTFailed(anomalyState)) {
+        dataGenerator.stopSequence();
+    }
+}
+
+// 初始化异常状态
+// 注意：这里不会重置传感器故障状态，因为停车后传感器故障并不会消失
+void Simulation::initAnomalyState() {
+    anomalyState.EGTOverSpeedLevel = 0;
+    anomalyState.N1OverSpeedLevel = 0;
+    anomalyState.FFOverSpeed = false;
+}
+
+// 状态查询
+bool Simulation::isRunning() const {
+    return running;
+}
+double Simulation::time() const {
+    return globalTime;
+}
+uint64_t Simulation::tick() const {
+    return tickCount;
+}
+uint64_t Simulation::stepCount() const {
+    return stepCounter;
+}
+const SensorData& Simulation::data() const {
+    return currentData;
+}
+const AnomalyState& Simulation::anomaly() const {
+    return anomalyState;
+}
+
+// 内部模块
+DataGenerator& Simulation::generator() {
+    return dataGenerator;
+}
@@ -0,0 +1,158 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "EngineState.h"
+#include "DataGenerator.h"
+#include "SampleRing.h"
+#include "TickStats.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 操作指令（与界面上的按钮一一对应）
+enum class Command {
+    Start,
+    Stop,
+    IncreaseThrust,
+    DecreaseThrust,
+    N1LS1Fail,
+    N1RS1Fail,
+    N1LS2Fail,
+    N1RS2Fail,
+    EGTLS1Fail,
+    EGTRS1Fail,
+    EGTLS2Fail,
+    EGTRS2Fail,
+    N1SFail,
+    EGTSFail,
+    FuelSFail,
+    N1OverSpeed1,
+    N1OverSpeed2,
+    EGTOverSpeed1,
+    EGTOverSpeed2,
+    EGTOverSpeed3,
+    EGTOverSpeed4,
+    FFOverSpeed,
+    LowFuel,
+    Count
+};
+
+// 指令与名称互相转换（用于脚本文件和命令行）
+const char* commandName(Command command);
+bool commandFromName(const std::string& name, Command& command);
+
+// 单步或指令的执行结果，告知调用方需要刷新的部分
+struct StepResult {
+    bool sensorChanged;    // 传感器故障状态可能变化
+    bool speedChanged;     // 超转/超温/流速状态可能变化
+    bool finished;         // 停车完成，本次模拟结束
+
+    StepResult() : sensorChanged(false), speedChanged(false), finished(false) {
+    }
+};
+
+// 无界面的模拟核心：数据生成 + 异常检测
+// 界面程序和命令行批处理程序共用同一套逻辑，每次 step() 推进一个 TIME_STEP。
+// 每一步以及每条指令执行后，当前状态作为 Sample 写入所有已注册的消费者缓冲区，
+// 日志、仪表等消费者各自按需读取，不占用模拟步内的时间
+class Simulation {
+public:
+    Simulation();
+
+    // 注册/注销样本消费者缓冲区（须在生产线程启动前完成）
+    void addConsumer(SampleRing<Sample>* ring);
+    void removeConsumer(SampleRing<Sample>* ring);
+
+    // 设置随机种子（相同种子 + 相同指令时序得到逐位相同的数据）
+    void setSeed(uint64_t value);
+    uint64_t seed() const;
+
+    // 重置为刚构造并以 value 播种时的状态（保留已注册的消费者和指令回调），用于回放
+    void reset(uint64_t value);
+
+    // 检查点（见 Checkpoint.h）：保存/恢复全部模拟状态，消费者和指令回调不变
+    void saveState(CheckpointWriter& writer) const;
+    bool loadState(CheckpointReader& reader);
+
+    // 指令回调：每条指令执行前以当前累计步数调用，用于记录输入日志
+    using CommandCallback = std::function<void(uint64_t step, Command command)>;
+    void setCommandCallback(CommandCallback callback);
+
+    // 实时性统计：每一步记录数据生成、规则求值、发布的耗时（须在生产线程启动前设置，为空则不计时）
+    void setStats(TickStats* stats);
+
+    // 执行一条操作指令
+    StepResult apply(Command command);
+
+    // 推进一个时间步长
+    StepResult step();
+
+    // 快进到本次运行的第 tick 步，结果与逐步推进逐位一致。
+    // 只能向前：未运行（未启动或停车已完成）或 tick 不晚于当前步时不做任何事并返回 false，
+    // 回到之前的时刻需要先恢复检查点再快进；途中停车完成时停在完成的那一步。
+    // 稳态中先按通道上下界二分跳过规则结果不会变化的区间；噪声跨过门限使上下界失效后，
+    // 改为按步数直接求出每步的通道值并只对规则求值，跳到下一次规则结果改变的步。
+    // 只有规则结果改变的步和启动、停车阶段（各约 10 秒以内）逐步推进，耗时不超过逐步推进，通道远离门限时与跨度基本无关；
+    // 跳过和快进途中的步不发布给消费者，只在结束时发布一次当前状态
+    bool seek(uint64_t tick);
+
+    // 状态查询
+    bool isRunning() const;
+    double time() const;
+    uint64_t tick() const;
+    uint64_t stepCount() const;   // 自构造或 reset() 以来累计推进的步数（启动时不清零）
+    const SensorData& data() const;
+    const AnomalyState& anomaly() const;
+
+    // 内部模块
+    DataGenerator& generator();
+
+private:
+    // 将当前状态发布给所有消费者
+    void publish(bool stepped);
+
+    // 按阈值规则表检查数据异常，更新异常状态和本步告警
+    void checkData(StepResult& result);
+
+    // 稳态中从当前步起到 tick 为止阈值规则结果都不会变化
+    bool rulesSteadyUntil(uint64_t tick) const;
+
+    // 稳态中逐步求出从下一步起各步的通道值并对规则求值，返回规则结果不变的最后一步（不超过 tick）
+    uint64_t rulesSteadyScan(uint64_t tick) const;
+
+    // 传感器全部故障时触发停车
+    void checkSensorFailure();
+
+    // 停车完成后重置超限状态（传感器故障不会因停车消失）
+    void initAnomalyState();
+
+    // 数据生成器
+    DataGenerator dataGenerator;
+
+    // 样本消费者
+    std::vector<SampleRing<Sample>*> consumers;
+
+    // 当前数据和异常状态
+    SensorData currentData;
+    AnomalyState anomalyState;
+
+    // 本步触发的告警位
+    uint32_t currentAlerts;
+
+    // 指令回调
+    CommandCallback commandCallback;
+
+    // 实时性统计
+    TickStats* stats;
+
+    // 模拟时间与步数
+    double globalTime;
+    uint64_t tickCount;
+    uint64_t stepCounter;
+
+    // 是否正在运行
+    bool running;
+};
+
+#endif // SIMULATION_H
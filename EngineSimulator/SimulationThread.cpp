@@ -0,0 +1,156 @@
+#include "SimulationThread.h"
+#include "SpanTrace.h"
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+// 构造与析构
+SimulationThread::SimulationThread(QObject* parent)
+    : QThread(parent), replayThrottle(nullptr), dropped(0), stats(nullptr) {
+}
+SimulationThread::~SimulationThread() {
+    requestInterruption();
+    wait();
+}
+
+// 模拟核心
+Simulation& SimulationThread::simulation() {
+    return core;
+}
+
+// 投递操作指令
+void SimulationThread::postCommand(Command command) {
+    QMutexLocker locker(&commandMutex);
+    pendingCommands.append(command);
+}
+
+// 丢弃的步数
+uint64_t SimulationThread::droppedSteps() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+// 实时性统计
+void SimulationThread::setStats(TickStats* value) {
+    stats = value;
+}
+
+// 输入日志记录：回调在模拟线程中执行，记录器只由模拟线程访问
+bool SimulationThread::recordTo(const QString& path) {
+    if (!recorder.open(path.toLocal8Bit().toStdString(), core.seed())) {
+        return false;
+    }
+    core.setCommandCallback([this](uint64_t step, Command command) {
+        recorder.record(step, command);
+    });
+    return true;
+}
+
+// 投递回放请求
+void SimulationThread::replay(const Journal& journal, SampleRing<Sample>* throttle) {
+    QMutexLocker locker(&commandMutex);
+    pendingReplay = std::make_unique<JournalPlayer>(journal);
+    replayThrottle = throttle;
+}
+
+// 回放：不受真实时间约束，按批推进
+void SimulationThread::runReplay(JournalPlayer& player, SampleRing<Sample>* throttle) {
+    // 当前会话的输入日志到此结束，回放本身不再记录
+    recorder.close(core.stepCount());
+    core.setCommandCallback(nullptr);
+
+    player.begin(core);
+    bool more = true;
+    while (more && !isInterruptionRequested()) {
+        for (int i = 0; i < REPLAY_BATCH_STEPS && more; ++i) {
+            more = player.advance(core);
+        }
+        while (throttle && throttle->size() > throttle->capacity() / 2 && !isInterruptionRequested()) {
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    // 回放期间投递的界面指令作废
+    {
+        QMutexLocker locker(&commandMutex);
+        pendingCommands.clear();
+    }
+    emit replayFinished(player.diverged());
+}
+
+// 线程主循环
+void SimulationThread::run() {
+    trace::setThreadName("simulation");
+    // 单调时钟，不受系统时间调整影响
+    QElapsedTimer clock;
+    clock.start();
+    qint64 lastNs = clock.nsecsElapsed();
+    double accumulator = 0.0;
+
+    while (!isInterruptionRequested()) {
+        // 执行界面投递的指令或回放请求
+        QVector<Command> commands;
+        std::unique_ptr<JournalPlayer> player;
+        SampleRing<Sample>* throttle = nullptr;
+        {
+            QMutexLocker locker(&commandMutex);
+            commands.swap(pendingCommands);
+            player.swap(pendingReplay);
+            throttle = replayThrottle;
+        }
+        if (player) {
+            runReplay(*player, throttle);
+            lastNs = clock.nsecsElapsed();
+            accumulator = 0.0;
+            continue;
+        }
+        for (Command command : commands) {
+            core.apply(command);
+        }
+
+        // 按真实流逝时间累加，未运行时不积累
+        qint64 nowNs = clock.nsecsElapsed();
+        double elapsed = (nowNs - lastNs) * 1e-9;
+        lastNs = nowNs;
+        if (core.isRunning()) {
+            accumulator += elapsed;
+        }
+        else {
+            accumulator = 0.0;
+        }
+
+        // 累加器每满一个 TIME_STEP 到期一步：最早一步在 (accumulator - TIME_STEP) 秒前到期，即本次唤醒的延迟
+        if (stats && accumulator >= TIME_STEP && core.isRunning()) {
+            stats->timerLateness.record(static_cast<uint64_t>((accumulator - TIME_STEP) * 1e9));
+        }
+
+        // 以固定步长补齐应推进的步数
+        int steps = 0;
+        while (accumulator >= TIME_STEP && core.isRunning()) {
+            if (steps == MAX_CATCH_UP_STEPS) {
+                uint64_t skipped = static_cast<uint64_t>(accumulator / TIME_STEP);
+                dropped.fetch_add(skipped, std::memory_order_relaxed);
+                if (stats) stats->addOverruns(skipped);
+                trace::instant("dropped");
+                accumulator -= skipped * TIME_STEP;
+                break;
+            }
+            {
+                TRACE_SPAN("step");
+                core.step();
+            }
+            // 完成时刻晚于本步到期时刻超过一个步长即为超时
+            if (stats && (clock.nsecsElapsed() - nowNs) * 1e-9 + accumulator - TIME_STEP > TIME_STEP) {
+                stats->addOverruns(1);
+                trace::instant("overrun");
+            }
+            accumulator -= TIME_STEP;
+            ++steps;
+        }
+
+        // 休眠到下一步到期
+        double wait = TIME_STEP - accumulator;
+        if (wait > 0.0) {
+            QThread::usleep(static_cast<unsigned long>(wait * 1e6));
+        }
+    }
+    recorder.close(core.stepCount());
+}
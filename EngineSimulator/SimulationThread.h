@@ -0,0 +1,80 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "Simulation.h"
+#include "InputJournal.h"
+#include <QThread>
+#include <QMutex>
+#include <QVector>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+// 独立的模拟线程
+// 以单调时钟驱动固定步长累加器：每次唤醒按流逝的真实时间补齐应推进的 TIME_STEP 步数，
+// 界面卡顿不会拖慢或漂移模拟时间；每一步的状态由模拟核心写入各消费者的无锁缓冲区，
+// 指令通过队列交给本线程执行
+class SimulationThread : public QThread {
+    Q_OBJECT
+
+public:
+    explicit SimulationThread(QObject* parent = nullptr);
+    ~SimulationThread() override;
+
+    // 模拟核心（仅允许在线程启动前配置，如注册样本消费者）
+    Simulation& simulation();
+
+    // 投递一条操作指令，在模拟线程的下一次唤醒时执行
+    void postCommand(Command command);
+
+    // 因单次补步超过上限而丢弃的步数
+    uint64_t droppedSteps() const;
+
+    // 实时性统计：唤醒延迟和超时步数（须在线程启动前设置；各阶段耗时另由模拟核心和 Logger 记录）
+    void setStats(TickStats* stats);
+
+    // 将种子和全部指令记录到输入日志（须在线程启动前调用），线程退出或开始回放时写入结束标记
+    bool recordTo(const QString& path);
+
+    // 回放输入日志：在模拟线程中重置模拟核心并以最快速度重现，回放期间界面指令被忽略。
+    // throttle 为不允许丢样本的消费者缓冲区（日志），过半满时等待其消费
+    void replay(const Journal& journal, SampleRing<Sample>* throttle);
+
+signals:
+    // 回放结束，diverged 表示日志与回放状态不一致
+    void replayFinished(bool diverged);
+
+protected:
+    // 线程主循环
+    void run() override;
+
+private:
+    // 单次唤醒最多补齐的步数（1 秒），防止长时间阻塞后陷入追赶
+    static constexpr int MAX_CATCH_UP_STEPS = 200;
+
+    // 回放时每批推进的步数，批间检查中断请求
+    static constexpr int REPLAY_BATCH_STEPS = 256;
+
+    // 在本线程内执行回放
+    void runReplay(JournalPlayer& player, SampleRing<Sample>* throttle);
+
+    // 模拟核心，仅在本线程内访问
+    Simulation core;
+
+    // 待执行指令
+    QMutex commandMutex;
+    QVector<Command> pendingCommands;
+    std::unique_ptr<JournalPlayer> pendingReplay;
+    SampleRing<Sample>* replayThrottle;
+
+    // 输入日志记录
+    JournalWriter recorder;
+
+    // 丢弃的步数
+    std::atomic<uint64_t> dropped;
+
+    // 实时性统计
+    TickStats* stats;
+};
+
+#endif // SIMULATIONTHREAD_H
@@ -0,0 +1,176 @@
+#include "SpanTrace.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> trace::enabledFlag{ false };
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;   // 0 表示瞬时事件
+};
+
+// 一个线程的缓冲区：events 和 written 只由所属线程写入
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::string name;
+    uint64_t session = 0;                 // 所属追踪会话，与当前会话不同时在下一次记录时重建
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> written{ 0 };   // 累计写入数，第 i 个事件位于 events[i % 容量]
+};
+
+// 全部线程的缓冲区（线程退出后保留，已结束线程的事件照样写出）
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    uint32_t nextTid = 1;
+    std::atomic<uint64_t> session{ 0 };
+    size_t capacity = TRACE_EVENTS_PER_THREAD;
+    uint64_t originNs = 0;
+    bool active = false;
+};
+
+// 停止时环形缓冲区最旧的这几个槽位不写出：停止前刚通过开关检查的线程可能仍在覆盖它们
+constexpr uint64_t STOP_MARGIN = 16;
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local std::shared_ptr<ThreadBuffer> currentBuffer;
+
+// 当前线程的缓冲区（首次调用时注册）
+ThreadBuffer& threadBuffer() {
+    if (!currentBuffer) {
+        Registry& reg = registry();
+        auto buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->tid = reg.nextTid++;
+        reg.buffers.push_back(buffer);
+        currentBuffer = buffer;
+    }
+    return *currentBuffer;
+}
+
+// JSON 字符串转义
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+} // namespace
+
+// 写入当前线程的缓冲区；每个会话的第一个事件持锁重建缓冲区，之后不加锁、不分配
+void trace::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    if (!enabled()) return;
+    Registry& reg = registry();
+    ThreadBuffer& buffer = threadBuffer();
+    if (buffer.session != reg.session.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.active) return;
+        buffer.events.assign(reg.capacity, TraceEvent{ nullptr, 0, 0 });
+        buffer.written.store(0, std::memory_order_relaxed);
+        buffer.session = reg.session.load(std::memory_order_relaxed);
+    }
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % buffer.events.size()] = { name, startNs, endNs };
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void trace::instant(const char* name) {
+    if (!enabled()) return;
+    record(name, statsClockNs(), 0);
+}
+
+void trace::setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+bool startTracing(size_t eventsPerThread) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (reg.active) return false;
+    reg.capacity = std::max<size_t>(eventsPerThread, STOP_MARGIN * 64);
+    reg.originNs = statsClockNs();
+    reg.session.fetch_add(1, std::memory_order_release);
+    reg.active = true;
+    trace::enabledFlag.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool tracingActive() {
+    return trace::enabled();
+}
+
+// 停止：先关开关，再持锁复制各线程本次会话的事件，最后在锁外写文件
+bool stopTracing(const std::string& path) {
+    struct ThreadEvents {
+        uint32_t tid;
+        std::string name;
+        std::vector<TraceEvent> events;
+    };
+    std::vector<ThreadEvents> threads;
+    uint64_t overwritten = 0;
+    uint64_t originNs;
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.active) return false;
+        trace::enabledFlag.store(false, std::memory_order_relaxed);
+        reg.active = false;
+        originNs = reg.originNs;
+        const uint64_t session = reg.session.load(std::memory_order_relaxed);
+        for (const std::shared_ptr<ThreadBuffer>& buffer : reg.buffers) {
+            ThreadEvents copy{ buffer->tid, buffer->name, {} };
+            if (buffer->session == session) {
+                const uint64_t written = buffer->written.load(std::memory_order_acquire);
+                const uint64_t capacity = buffer->events.size();
+                const uint64_t first = written > capacity ? written - capacity + STOP_MARGIN : 0;
+                overwritten += first;
+                copy.events.reserve(static_cast<size_t>(written - first));
+                for (uint64_t i = first; i < written; ++i) {
+                    copy.events.push_back(buffer->events[i % capacity]);
+                }
+            }
+            threads.push_back(std::move(copy));
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"overwrittenEvents\":%llu},\"traceEvents\":[\n",
+        static_cast<unsigned long long>(overwritten));
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"EngineSimulator\"}}", file);
+    for (const ThreadEvents& thread : threads) {
+        const std::string name = thread.name.empty() ? "thread " + std::to_string(thread.tid) : thread.name;
+        std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":%s}}",
+            thread.tid, jsonString(name).c_str());
+        for (const TraceEvent& event : thread.events) {
+            // 时间戳为相对追踪开始的微秒
+            const double ts = (static_cast<double>(event.start) - static_cast<double>(originNs)) * 1e-3;
+            if (event.end == 0) {
+                std::fprintf(file, ",\n{\"name\":%s,\"cat\":\"engine\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                    jsonString(event.name).c_str(), thread.tid, ts);
+            }
+            else {
+                std::fprintf(file, ",\n{\"name\":%s,\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    jsonString(event.name).c_str(), thread.tid, ts, (event.end - event.start) * 1e-3);
+            }
+        }
+    }
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
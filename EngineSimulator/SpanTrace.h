@@ -0,0 +1,65 @@
+#ifndef SPANTRACE_H
+#define SPANTRACE_H
+
+#include "TickStats.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 跨度追踪（Chrome / Perfetto trace event 格式）
+// 开启后，TRACE_SPAN 所在作用域的起止时间写入当前线程私有的环形缓冲区（单写者，无锁、无分配），
+// 缓冲区满时覆盖最旧的事件，保留最近一段时间；stopTracing() 汇总全部线程的缓冲区，
+// 写为 chrome://tracing 和 ui.perfetto.dev 可直接打开的 JSON。
+// 关闭时每个 TRACE_SPAN 只是一次 relaxed 原子读和一次分支。
+// 跨度名称必须是静态存储期的字符串（字面量），缓冲区只保存指针。时间与 TickStats 使用同一时钟
+
+namespace trace {
+
+extern std::atomic<bool> enabledFlag;
+
+inline bool enabled() {
+    return enabledFlag.load(std::memory_order_relaxed);
+}
+
+// 记录一个跨度 / 瞬时事件（追踪关闭时丢弃）
+void record(const char* name, uint64_t startNs, uint64_t endNs);
+void instant(const char* name);
+
+// 当前线程在追踪中显示的名称
+void setThreadName(const char* name);
+
+} // namespace trace
+
+// 每个线程默认保留的事件数（每个事件 24 字节）
+constexpr size_t TRACE_EVENTS_PER_THREAD = size_t(1) << 18;
+
+// 开始追踪（已在追踪时返回 false）；各线程缓冲区在该线程下一次记录时按容量重建
+bool startTracing(size_t eventsPerThread = TRACE_EVENTS_PER_THREAD);
+
+// 停止追踪并写出 JSON（未在追踪或写文件失败返回 false）
+bool stopTracing(const std::string& path);
+
+bool tracingActive();
+
+// 作用域跨度
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name(name), start(trace::enabled() ? statsClockNs() : 0) {
+    }
+    ~TraceSpan() {
+        if (start != 0) trace::record(name, start, statsClockNs());
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+
+#endif // SPANTRACE_H
@@ -0,0 +1,219 @@
+#include "SweepRunner.h"
+#include "Checkpoint.h"
+#include "DataGenerator.h"
+#include "Logger.h"
+#include "Random.h"
+#include "SampleRing.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// 场景展开所用随机流与模拟种子的区分常数（两者不共用一条序列）
+static constexpr uint64_t SCENARIO_STREAM = 0x5CE7A210D1CE5EEDull;
+
+// 解析时间字段："12.5" 或 "10..20"
+static bool parseTimeRange(const std::string& text, double& minTime, double& maxTime) {
+    const size_t dots = text.find("..");
+    char* end = nullptr;
+    if (dots == std::string::npos) {
+        minTime = maxTime = std::strtod(text.c_str(), &end);
+        return end != text.c_str() && *end == '\0';
+    }
+    const std::string low = text.substr(0, dots);
+    const std::string high = text.substr(dots + 2);
+    minTime = std::strtod(low.c_str(), &end);
+    if (end == low.c_str() || *end != '\0') return false;
+    maxTime = std::strtod(high.c_str(), &end);
+    if (end == high.c_str() || *end != '\0') return false;
+    return minTime <= maxTime;
+}
+
+// 读取场景模板，"duration <s>" 行设置单次运行的最长模拟时间
+bool loadScenario(const std::string& path, Scenario& scenario, std::string& error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::istringstream fields(line);
+        std::string timeText;
+        if (!(fields >> timeText) || timeText[0] == '#') continue;
+
+        const std::string where = path + ":" + std::to_string(lineNumber) + ": ";
+        if (timeText == "duration") {
+            if (!(fields >> scenario.duration) || scenario.duration <= 0.0) {
+                error = where + "invalid duration";
+                return false;
+            }
+            continue;
+        }
+
+        ScenarioEvent event;
+        std::string name;
+        if (!parseTimeRange(timeText, event.minTime, event.maxTime)) {
+            error = where + "invalid time \"" + timeText + "\"";
+            return false;
+        }
+        if (!(fields >> name) || !commandFromName(name, event.command)) {
+            error = where + "unknown command \"" + name + "\"";
+            return false;
+        }
+        if (!(fields >> event.probability)) {
+            event.probability = 1.0;
+        }
+        if (event.probability < 0.0 || event.probability > 1.0) {
+            error = where + "probability must be within [0, 1]";
+            return false;
+        }
+        scenario.events.push_back(event);
+    }
+    return true;
+}
+
+// 按种子展开场景模板：每条指令依次取一个出现判定和一个时间，与是否出现无关地消耗随机数，
+// 保证修改某条指令的概率不影响其他指令的取值
+std::vector<ScheduledCommand> expandScenario(const Scenario& scenario, uint64_t seed) {
+    Xoshiro256PlusPlus rng(seed ^ SCENARIO_STREAM);
+    std::vector<ScheduledCommand> commands;
+    commands.reserve(scenario.events.size());
+    for (const ScenarioEvent& event : scenario.events) {
+        const double chance = uniform01(rng);
+        const double time = event.minTime + uniform01(rng) * (event.maxTime - event.minTime);
+        if (chance < event.probability) {
+            commands.push_back({ time, event.command });
+        }
+    }
+    std::stable_sort(commands.begin(), commands.end(),
+        [](const ScheduledCommand& a, const ScheduledCommand& b) { return a.time < b.time; });
+    return commands;
+}
+
+// 以指定种子运行一次场景（模拟核心、日志告警检测都是本次运行私有的，可在任意线程并行调用）
+RunOutcome runScenario(const Scenario& scenario, uint64_t seed, const std::vector<uint8_t>* checkpoint) {
+    RunOutcome outcome;
+    outcome.seed = seed;
+
+    const std::vector<ScheduledCommand> commands = expandScenario(scenario, seed);
+
+    Simulation simulation;
+    simulation.setSeed(seed);
+    SampleRing<Sample> ring(64);
+    simulation.addConsumer(&ring);
+
+    // 未设置日志目录的 Logger 只做告警检测，与界面和批处理的告警规则一致
+    Logger logger;
+    logger.setAlertCallback([&outcome](double, AlertLevel, const std::string& text) {
+        ++outcome.alertCount;
+        const size_t prefixEnd = text.find("] ");
+        std::string message = prefixEnd == std::string::npos ? text : text.substr(prefixEnd + 2);
+        if (std::find(outcome.alerts.begin(), outcome.alerts.end(), message) == outcome.alerts.end()) {
+            outcome.alerts.push_back(std::move(message));
+        }
+    });
+
+    if (checkpoint) {
+        restoreCheckpoint(*checkpoint, simulation, &logger);
+        simulation.setSeed(seed);
+    }
+
+    // 燃油消耗只累计时间步内的下降，指令造成的跳变（低油量注入/恢复）不计入
+    double lastFuel = simulation.data().fuelLevel;
+    auto consume = [&](const Sample& sample) {
+        logger.consume(sample);
+        if (sample.stepped) {
+            const SensorData processed = DataGenerator::processData(sample.data);
+            outcome.peakEgt = std::max({ outcome.peakEgt, processed.egtLeftAverage, processed.egtRightAverage });
+            if (sample.data.fuelLevel < lastFuel) {
+                outcome.fuelUsed += lastFuel - sample.data.fuelLevel;
+            }
+            if (outcome.timeToStable < 0.0 && sample.data.phase == EnginePhase::Stable) {
+                outcome.timeToStable = sample.time;
+            }
+        }
+        lastFuel = sample.data.fuelLevel;
+    };
+
+    const uint64_t totalTicks = static_cast<uint64_t>(scenario.duration / TIME_STEP + 0.5);
+    size_t next = 0;
+    for (uint64_t tick = 0; tick < totalTicks; ++tick) {
+        const double now = tick * TIME_STEP;
+        while (next < commands.size() && commands[next].time <= now + TIME_STEP * 0.5) {
+            simulation.apply(commands[next].command);
+            ++next;
+        }
+        ring.drain(consume);
+        // 引擎已停且后续没有指令，提前结束
+        if (!simulation.isRunning() && next >= commands.size()) {
+            break;
+        }
+        simulation.step();
+    }
+    ring.drain(consume);
+    logger.close();
+
+    outcome.endTime = simulation.time();
+    return outcome;
+}
+
+// 并行扫描：每个种子一个任务，结果写入各自的槽位，运行期间线程之间不共享可写状态
+SweepSummary runSweep(const Scenario& scenario, uint64_t firstSeed, uint64_t lastSeed, size_t threads,
+    const std::vector<uint8_t>* checkpoint) {
+    SweepSummary summary;
+    if (lastSeed < firstSeed) return summary;
+    const size_t count = static_cast<size_t>(lastSeed - firstSeed) + 1;
+    summary.runs.resize(count);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(threads);
+        summary.threads = pool.threadCount();
+        for (size_t i = 0; i < count; ++i) {
+            pool.submit([&scenario, &summary, checkpoint, firstSeed, i]() {
+                summary.runs[i] = runScenario(scenario, firstSeed + i, checkpoint);
+            });
+        }
+        pool.wait();
+        summary.stolen = pool.stolenCount();
+    }
+    summary.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return summary;
+}
+
+// CSV 字段转义：含逗号、引号、换行时加引号
+static std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+// 将扫描结果写为 CSV（每个种子一行，告警以分号分隔）
+bool writeSweepSummary(const std::string& path, const SweepSummary& summary) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fputs("Seed,TimeToStable(s),PeakEGT,FuelUsed,EndTime(s),AlertCount,Alerts\n", file);
+    for (const RunOutcome& run : summary.runs) {
+        std::string alerts;
+        for (const std::string& alert : run.alerts) {
+            if (!alerts.empty()) alerts += ';';
+            alerts += alert;
+        }
+        std::fprintf(file, "%llu,%.3f,%.1f,%.1f,%.3f,%zu,%s\n",
+            static_cast<unsigned long long>(run.seed), run.timeToStable, run.peakEgt,
+            run.fuelUsed, run.endTime, run.alertCount, csvField(alerts).c_str());
+    }
+    return std::fclose(file) == 0;
+}
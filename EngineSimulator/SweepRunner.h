@@ -0,0 +1,73 @@
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include "Simulation.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 蒙特卡洛场景扫描
+// 场景模板描述一组带随机成分的定时指令，每个种子展开为一条具体指令序列并独立运行一次模拟。
+// 各次运行互不共享状态，由工作窃取线程池并行执行，结果按种子汇总为一个 CSV 文件。
+
+// 场景模板中的一条指令
+// 文件格式（每行一条，# 开头为注释）：
+//   <time_s>|<min_s>..<max_s> <Command> [probability]
+// 时间为区间时在区间内均匀取值；probability 为该指令出现的概率（默认 1）
+struct ScenarioEvent {
+    double minTime;       // 触发时间下限（秒）
+    double maxTime;       // 触发时间上限（秒）
+    Command command;      // 指令
+    double probability;   // 出现概率
+};
+
+struct Scenario {
+    std::vector<ScenarioEvent> events;
+    double duration = 600.0;   // 单次运行的最长模拟时间（秒）
+};
+
+// 读取场景模板
+bool loadScenario(const std::string& path, Scenario& scenario, std::string& error);
+
+// 按种子展开后的一条定时指令
+struct ScheduledCommand {
+    double time;
+    Command command;
+};
+
+// 按种子展开场景模板（相同种子得到相同指令序列，按时间排序）
+std::vector<ScheduledCommand> expandScenario(const Scenario& scenario, uint64_t seed);
+
+// 单次运行结果
+struct RunOutcome {
+    uint64_t seed = 0;
+    double timeToStable = -1.0;      // 首次进入稳态的模拟时间（秒），未进入为 -1
+    double peakEgt = 0.0;            // 两发 EGT 峰值
+    double fuelUsed = 0.0;           // 燃油消耗（不含低油量注入造成的跳变）
+    double endTime = 0.0;            // 运行结束时的模拟时间
+    size_t alertCount = 0;           // 触发的告警条数（已按 5 秒去重）
+    std::vector<std::string> alerts; // 触发过的告警（不含时间前缀，按首次出现顺序去重）
+};
+
+// 以指定种子运行一次场景
+// checkpoint 非空时先从该检查点恢复，再以 seed 重新播种随机数发生器（同一状态分叉出不同的随机序列），
+// 场景时间从恢复时刻起计
+RunOutcome runScenario(const Scenario& scenario, uint64_t seed, const std::vector<uint8_t>* checkpoint = nullptr);
+
+// 扫描汇总
+struct SweepSummary {
+    std::vector<RunOutcome> runs;  // 按种子升序
+    size_t threads = 0;
+    uint64_t stolen = 0;           // 被其他线程窃取执行的任务数
+    double wallSeconds = 0.0;
+};
+
+// 对 [firstSeed, lastSeed] 内的每个种子运行一次场景；threads 为 0 时使用全部硬件线程
+SweepSummary runSweep(const Scenario& scenario, uint64_t firstSeed, uint64_t lastSeed, size_t threads,
+    const std::vector<uint8_t>* checkpoint = nullptr);
+
+// 将扫描结果写为 CSV
+bool writeSweepSummary(const std::string& path, const SweepSummary& summary);
+
+#endif // SWEEPRUNNER_H
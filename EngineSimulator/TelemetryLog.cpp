@@ -0,0 +1,582 @@
+#include "TelemetryLog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int CHANNEL_COUNT = static_cast<int>(TelemetryChannel::Count);
+constexpr uint32_t FILE_VERSION = 1;
+constexpr uint32_t BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+constexpr char FILE_MAGIC[8] = { 'E', 'S', 'T', 'L', 'M', '0', '1', '\0' };
+
+// 文件头（按小端序直接写出）
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t columnCount;
+    uint32_t blockRows;
+    uint32_t reserved;
+    double timeStep;
+    char padding[32];
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout");
+
+// 块头
+struct BlockHeader {
+    uint32_t magic;
+    uint32_t rows;
+    double firstTime;
+    double lastTime;
+};
+static_assert(sizeof(BlockHeader) == 24, "BlockHeader layout");
+
+// 索引文件头与索引项（按小端序直接写出）
+constexpr uint32_t INDEX_VERSION = 1;
+constexpr char INDEX_MAGIC[8] = { 'E', 'S', 'T', 'L', 'X', '0', '1', '\0' };
+
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t coveredBytes;   // 索引覆盖的 .tlm 长度（末块结束位置）
+    uint64_t blockCount;
+};
+static_assert(sizeof(IndexHeader) == 32, "IndexHeader layout");
+
+struct IndexEntry {
+    uint64_t offset;
+    uint32_t rows;
+    uint32_t reserved;
+    double firstTime;
+    double lastTime;
+};
+static_assert(sizeof(IndexEntry) == 32, "IndexEntry layout");
+
+// 各列在块内的偏移（相对块头起点）
+struct BlockLayout {
+    size_t time;
+    size_t values[CHANNEL_COUNT];
+    size_t anomaly;
+    size_t phase;
+    size_t valid;
+    size_t total;
+};
+
+BlockLayout blockLayout(uint32_t rows) {
+    BlockLayout layout;
+    size_t offset = sizeof(BlockHeader);
+    layout.time = offset;
+    offset += rows * sizeof(double);
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        layout.values[c] = offset;
+        offset += rows * sizeof(float);
+    }
+    layout.anomaly = offset;
+    offset += rows * sizeof(uint16_t);
+    layout.phase = offset;
+    offset += rows;
+    layout.valid = offset;
+    offset += rows;
+    layout.total = (offset + 7) & ~static_cast<size_t>(7);
+    return layout;
+}
+
+} // namespace
+
+// 异常状态打包：bit0-8 传感器故障，bit9-10 N1 超转等级，bit11-13 EGT 超温等级，bit14 低油量，bit15 流速超限
+uint16_t packAnomaly(const AnomalyState& anomaly) {
+    uint16_t bits = 0;
+    bits |= anomaly.N1LS1Fail ? 1u << 0 : 0u;
+    bits |= anomaly.N1RS1Fail ? 1u << 1 : 0u;
+    bits |= anomaly.N1LS2Fail ? 1u << 2 : 0u;
+    bits |= anomaly.N1RS2Fail ? 1u << 3 : 0u;
+    bits |= anomaly.EGTLS1Fail ? 1u << 4 : 0u;
+    bits |= anomaly.EGTRS1Fail ? 1u << 5 : 0u;
+    bits |= anomaly.EGTLS2Fail ? 1u << 6 : 0u;
+    bits |= anomaly.EGTRS2Fail ? 1u << 7 : 0u;
+    bits |= anomaly.FuelSFail ? 1u << 8 : 0u;
+    bits |= static_cast<uint16_t>((anomaly.N1OverSpeedLevel & 0x3) << 9);
+    bits |= static_cast<uint16_t>((anomaly.EGTOverSpeedLevel & 0x7) << 11);
+    bits |= anomaly.LowFuel ? 1u << 14 : 0u;
+    bits |= anomaly.FFOverSpeed ? 1u << 15 : 0u;
+    return bits;
+}
+
+AnomalyState unpackAnomaly(uint16_t bits) {
+    AnomalyState anomaly;
+    anomaly.N1LS1Fail = (bits >> 0) & 1;
+    anomaly.N1RS1Fail = (bits >> 1) & 1;
+    anomaly.N1LS2Fail = (bits >> 2) & 1;
+    anomaly.N1RS2Fail = (bits >> 3) & 1;
+    anomaly.EGTLS1Fail = (bits >> 4) & 1;
+    anomaly.EGTRS1Fail = (bits >> 5) & 1;
+    anomaly.EGTLS2Fail = (bits >> 6) & 1;
+    anomaly.EGTRS2Fail = (bits >> 7) & 1;
+    anomaly.FuelSFail = (bits >> 8) & 1;
+    anomaly.N1OverSpeedLevel = (bits >> 9) & 0x3;
+    anomaly.EGTOverSpeedLevel = (bits >> 11) & 0x7;
+    anomaly.LowFuel = (bits >> 14) & 1;
+    anomaly.FFOverSpeed = (bits >> 15) & 1;
+    return anomaly;
+}
+
+// 有效位与文本日志的 N/A 判断保持一致
+uint8_t validMask(const AnomalyState& anomaly) {
+    uint8_t mask = 0;
+    if (!(anomaly.N1LS1Fail && anomaly.N1LS2Fail)) mask |= VALID_N1_LEFT;
+    if (!(anomaly.N1RS1Fail && anomaly.N1RS2Fail)) mask |= VALID_N1_RIGHT;
+    if (!(anomaly.EGTLS1Fail && anomaly.EGTLS2Fail)) mask |= VALID_EGT_LEFT;
+    if (!(anomaly.EGTRS1Fail && anomaly.EGTRS2Fail)) mask |= VALID_EGT_RIGHT;
+    if (!anomaly.FuelSFail) mask |= VALID_FUEL_LEVEL;
+    if (!anomaly.FFOverSpeed) mask |= VALID_FUEL_FLOW;
+    return mask;
+}
+
+// ---------------- 写入端 ----------------
+
+TelemetryWriter::TelemetryWriter(uint32_t blockRows)
+    : file(nullptr), blockRows(blockRows == 0 ? DEFAULT_BLOCK_ROWS : blockRows), totalRows(0) {
+    timeColumn.reserve(this->blockRows);
+    for (auto& column : valueColumns) column.reserve(this->blockRows);
+    anomalyColumn.reserve(this->blockRows);
+    phaseColumn.reserve(this->blockRows);
+    validColumn.reserve(this->blockRows);
+    blockBuffer.resize(blockLayout(this->blockRows).total);
+}
+
+TelemetryWriter::~TelemetryWriter() {
+    close();
+}
+
+// 创建文件并写入文件头
+bool TelemetryWriter::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open telemetry log file: " << path << "\n";
+        return false;
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.columnCount = CHANNEL_COUNT + 4;
+    header.blockRows = blockRows;
+    header.timeStep = TIME_STEP;
+    std::fwrite(&header, sizeof(header), 1, file);
+    totalRows = 0;
+    return true;
+}
+
+// 追加一行
+void TelemetryWriter::append(double time, const SensorData& data, const AnomalyState& anomaly) {
+    if (!file) return;
+
+    timeColumn.push_back(time);
+    valueColumns[static_cast<int>(TelemetryChannel::N1Left)].push_back(static_cast<float>(data.n1LeftAverage));
+    valueColumns[static_cast<int>(TelemetryChannel::N1Right)].push_back(static_cast<float>(data.n1RightAverage));
+    valueColumns[static_cast<int>(TelemetryChannel::EGTLeft)].push_back(static_cast<float>(data.egtLeftAverage));
+    valueColumns[static_cast<int>(TelemetryChannel::EGTRight)].push_back(static_cast<float>(data.egtRightAverage));
+    valueColumns[static_cast<int>(TelemetryChannel::FuelLevel)].push_back(static_cast<float>(data.fuelLevel));
+    valueColumns[static_cast<int>(TelemetryChannel::FuelFlow)].push_back(static_cast<float>(data.fuelFlow));
+    anomalyColumn.push_back(packAnomaly(anomaly));
+    phaseColumn.push_back(static_cast<uint8_t>(data.phase));
+    validColumn.push_back(validMask(anomaly));
+    ++totalRows;
+
+    if (timeColumn.size() >= blockRows) {
+        writeBlock();
+    }
+}
+
+// 将当前块写出
+void TelemetryWriter::flush() {
+    if (!file) return;
+    writeBlock();
+    std::fflush(file);
+}
+
+// 写出剩余数据并关闭
+void TelemetryWriter::close() {
+    if (!file) return;
+    writeBlock();
+    std::fclose(file);
+    file = nullptr;
+}
+
+bool TelemetryWriter::isOpen() const {
+    return file != nullptr;
+}
+
+uint64_t TelemetryWriter::rowCount() const {
+    return totalRows;
+}
+
+// 序列化当前块：块头 + 各列，一次 fwrite 写出
+void TelemetryWriter::writeBlock() {
+    const uint32_t rows = static_cast<uint32_t>(timeColumn.size());
+    if (rows == 0) return;
+
+    const BlockLayout layout = blockLayout(rows);
+    char* base = blockBuffer.data();
+    std::memset(base + layout.valid + rows, 0, layout.total - layout.valid - rows);
+
+    BlockHeader header;
+    header.magic = BLOCK_MAGIC;
+    header.rows = rows;
+    header.firstTime = timeColumn.front();
+    header.lastTime = timeColumn.back();
+    std::memcpy(base, &header, sizeof(header));
+    std::memcpy(base + layout.time, timeColumn.data(), rows * sizeof(double));
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        std::memcpy(base + layout.values[c], valueColumns[c].data(), rows * sizeof(float));
+    }
+    std::memcpy(base + layout.anomaly, anomalyColumn.data(), rows * sizeof(uint16_t));
+    std::memcpy(base + layout.phase, phaseColumn.data(), rows);
+    std::memcpy(base + layout.valid, validColumn.data(), rows);
+    std::fwrite(base, layout.total, 1, file);
+
+    timeColumn.clear();
+    for (auto& column : valueColumns) column.clear();
+    anomalyColumn.clear();
+    phaseColumn.clear();
+    validColumn.clear();
+}
+
+// ---------------- 读取端 ----------------
+
+// 替换扩展名（无扩展名时追加）
+std::string telemetrySiblingPath(const std::string& path, const char* extension) {
+    const size_t dot = path.find_last_of('.');
+    const size_t slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + extension;
+    return path.substr(0, dot) + extension;
+}
+
+std::string telemetryIndexPath(const std::string& path) {
+    return telemetrySiblingPath(path, ".tlx");
+}
+
+MappedFile::MappedFile()
+    : mapped(nullptr), mappedSize(0)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mapped = static_cast<const char*>(view);
+    mappedSize = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    mapped = static_cast<const char*>(view);
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+// 解除映射
+void MappedFile::close() {
+    if (mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapped);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<char*>(mapped), mappedSize);
+#endif
+    }
+    mapped = nullptr;
+    mappedSize = 0;
+}
+
+const char* MappedFile::data() const {
+    return mapped;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
+
+TelemetryReader::TelemetryReader()
+    : mapped(nullptr), mappedSize(0), step(TIME_STEP), totalRows(0), loadedIndex(false), bucketWidth(0.0) {
+}
+
+TelemetryReader::~TelemetryReader() {
+    close();
+}
+
+// 打开并映射文件，加载索引或遍历块头建立块索引
+bool TelemetryReader::open(const std::string& path, bool useIndex) {
+    close();
+    if (!file.open(path)) return false;
+    if (file.size() < sizeof(FileHeader)) {
+        file.close();
+        return false;
+    }
+    mapped = file.data();
+    mappedSize = file.size();
+
+    // 校验文件头
+    FileHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != FILE_VERSION) {
+        std::cerr << "Not a telemetry log file: " << path << "\n";
+        close();
+        return false;
+    }
+    step = header.timeStep;
+
+    // 先加载索引，再遍历索引之后（或全部）的块头；尾部不完整的块（如写入中途崩溃）直接忽略
+    const std::string indexPath = telemetryIndexPath(path);
+    loadedIndex = useIndex && loadIndex(indexPath);
+    size_t offset = blocks.empty() ? sizeof(FileHeader) : blockOffsets.back() + blockLayout(blocks.back().rows).total;
+    const size_t indexedBlocks = blocks.size();
+    scanBlocks(offset);
+    if (useIndex && (!loadedIndex || blocks.size() != indexedBlocks) && !blocks.empty()) {
+        saveIndex(indexPath);
+    }
+    buildTimeBuckets();
+    return true;
+}
+
+// 从 offset 起遍历块头
+size_t TelemetryReader::scanBlocks(size_t offset) {
+    while (offset + sizeof(BlockHeader) <= mappedSize) {
+        BlockHeader blockHeader;
+        std::memcpy(&blockHeader, mapped + offset, sizeof(blockHeader));
+        if (blockHeader.magic != BLOCK_MAGIC || blockHeader.rows == 0) break;
+        const size_t total = blockLayout(blockHeader.rows).total;
+        if (offset + total > mappedSize) break;
+        addBlock(offset, blockHeader.rows, blockHeader.firstTime, blockHeader.lastTime);
+        offset += total;
+    }
+    return offset;
+}
+
+// 追加一个块视图：列指针由偏移直接算出，不访问映射内存
+void TelemetryReader::addBlock(size_t offset, uint32_t rows, double firstTime, double lastTime) {
+    const BlockLayout layout = blockLayout(rows);
+    const char* base = mapped + offset;
+    TelemetryBlock block;
+    block.firstRow = totalRows;
+    block.rows = rows;
+    block.firstTime = firstTime;
+    block.lastTime = lastTime;
+    block.time = reinterpret_cast<const double*>(base + layout.time);
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        block.values[c] = reinterpret_cast<const float*>(base + layout.values[c]);
+    }
+    block.anomaly = reinterpret_cast<const uint16_t*>(base + layout.anomaly);
+    block.phase = reinterpret_cast<const uint8_t*>(base + layout.phase);
+    block.valid = reinterpret_cast<const uint8_t*>(base + layout.valid);
+    blocks.push_back(block);
+    blockOffsets.push_back(offset);
+    totalRows += rows;
+}
+
+// 加载索引：各项须首尾相接且不超出文件，首末块的块头须与索引一致（防止同名文件已被覆盖）
+bool TelemetryReader::loadIndex(const std::string& indexPath) {
+    std::FILE* indexFile = std::fopen(indexPath.c_str(), "rb");
+    if (!indexFile) return false;
+    IndexHeader header;
+    std::vector<IndexEntry> entries;
+    bool ok = std::fread(&header, sizeof(header), 1, indexFile) == 1
+        && std::memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) == 0
+        && header.version == INDEX_VERSION
+        && header.blockCount > 0 && header.coveredBytes <= mappedSize;
+    if (ok) {
+        entries.resize(static_cast<size_t>(header.blockCount));
+        ok = std::fread(entries.data(), sizeof(IndexEntry), entries.size(), indexFile) == entries.size();
+    }
+    std::fclose(indexFile);
+    if (!ok) return false;
+
+    uint64_t expected = sizeof(FileHeader);
+    for (const IndexEntry& entry : entries) {
+        if (entry.offset != expected || entry.rows == 0) return false;
+        expected += blockLayout(entry.rows).total;
+    }
+    if (expected != header.coveredBytes) return false;
+    for (const IndexEntry* entry : { &entries.front(), &entries.back() }) {
+        BlockHeader blockHeader;
+        std::memcpy(&blockHeader, mapped + entry->offset, sizeof(blockHeader));
+        if (blockHeader.magic != BLOCK_MAGIC || blockHeader.rows != entry->rows
+            || blockHeader.firstTime != entry->firstTime || blockHeader.lastTime != entry->lastTime) {
+            return false;
+        }
+    }
+
+    blocks.reserve(entries.size());
+    blockOffsets.reserve(entries.size());
+    for (const IndexEntry& entry : entries) {
+        addBlock(static_cast<size_t>(entry.offset), entry.rows, entry.firstTime, entry.lastTime);
+    }
+    return true;
+}
+
+// 写出索引（失败不影响读取，如目录只读）
+bool TelemetryReader::saveIndex(const std::string& indexPath) const {
+    std::FILE* indexFile = std::fopen(indexPath.c_str(), "wb");
+    if (!indexFile) return false;
+    IndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = INDEX_VERSION;
+    header.coveredBytes = blockOffsets.back() + blockLayout(blocks.back().rows).total;
+    header.blockCount = blocks.size();
+    std::vector<IndexEntry> entries(blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        entries[i] = { blockOffsets[i], blocks[i].rows, 0, blocks[i].firstTime, blocks[i].lastTime };
+    }
+    const bool written = std::fwrite(&header, sizeof(header), 1, indexFile) == 1
+        && std::fwrite(entries.data(), sizeof(IndexEntry), entries.size(), indexFile) == entries.size();
+    return std::fclose(indexFile) == 0 && written;
+}
+
+// 时间分桶：桶宽取平均块时长，每个桶覆盖的块数与文件长度无关
+void TelemetryReader::buildTimeBuckets() {
+    bucketStart.clear();
+    bucketWidth = 0.0;
+    if (blocks.empty()) return;
+    const double span = blocks.back().lastTime - blocks.front().firstTime;
+    const double width = span / static_cast<double>(blocks.size());
+    if (!(width > 0.0) || !std::isfinite(width)) return;
+    bucketWidth = width;
+    bucketStart.resize(blocks.size() + 1);
+    size_t j = 0;
+    for (size_t k = 0; k < bucketStart.size(); ++k) {
+        const double threshold = blocks.front().firstTime + static_cast<double>(k) * bucketWidth;
+        while (j < blocks.size() && blocks[j].lastTime < threshold) ++j;
+        bucketStart[k] = static_cast<uint32_t>(j);
+    }
+}
+
+// 解除映射
+void TelemetryReader::close() {
+    file.close();
+    mapped = nullptr;
+    mappedSize = 0;
+    blocks.clear();
+    blockOffsets.clear();
+    totalRows = 0;
+    loadedIndex = false;
+    bucketStart.clear();
+    bucketWidth = 0.0;
+}
+
+bool TelemetryReader::isOpen() const {
+    return mapped != nullptr;
+}
+
+size_t TelemetryReader::rowCount() const {
+    return totalRows;
+}
+
+size_t TelemetryReader::blockCount() const {
+    return blocks.size();
+}
+
+const TelemetryBlock& TelemetryReader::block(size_t index) const {
+    return blocks[index];
+}
+
+double TelemetryReader::timeStep() const {
+    return step;
+}
+
+// 读取任意一行：按首行号二分定位块
+bool TelemetryReader::readRow(size_t row, TelemetryRow& out) const {
+    if (row >= totalRows) return false;
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), row,
+        [](size_t value, const TelemetryBlock& block) { return value < block.firstRow; });
+    const TelemetryBlock& block = *(it - 1);
+    const size_t i = row - block.firstRow;
+    out.time = block.time[i];
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        out.values[c] = block.values[c][i];
+    }
+    out.anomaly = block.anomaly[i];
+    out.phase = static_cast<EnginePhase>(block.phase[i]);
+    out.valid = block.valid[i];
+    return true;
+}
+
+bool TelemetryReader::indexLoaded() const {
+    return loadedIndex;
+}
+
+// 查找时间不小于 time 的第一行；超出末尾时返回 rowCount()。
+// 所在块必然位于 time 所在桶与下一个桶的起始块之间（两侧各多取一个桶以容忍舍入），只在这一小段内二分
+size_t TelemetryReader::findRow(double time) const {
+    auto first = blocks.begin();
+    auto last = blocks.end();
+    if (!bucketStart.empty()) {
+        const double position = (time - blocks.front().firstTime) / bucketWidth;
+        const size_t maxBucket = bucketStart.size() - 1;
+        const size_t k = position <= 0.0 ? 0
+            : position >= static_cast<double>(maxBucket) ? maxBucket : static_cast<size_t>(position);
+        first = blocks.begin() + bucketStart[k == 0 ? 0 : k - 1];
+        if (k + 2 <= maxBucket) last = std::min(blocks.end(), blocks.begin() + bucketStart[k + 2] + 1);
+    }
+    auto it = std::lower_bound(first, last, time,
+        [](const TelemetryBlock& block, double value) { return block.lastTime < value; });
+    if (it == blocks.end()) return totalRows;
+    const double* begin = it->time;
+    const double* found = std::lower_bound(begin, begin + it->rows, time);
+    return it->firstRow + static_cast<size_t>(found - begin);
+}
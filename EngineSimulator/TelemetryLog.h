@@ -0,0 +1,203 @@
+#ifndef TELEMETRYLOG_H
+#define TELEMETRYLOG_H
+
+#include "EngineState.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 二进制列式遥测日志（.tlm）
+// 文件 = 文件头 + 若干数据块；每个数据块内每个字段占一段连续的定长列，
+// 读取端内存映射后可直接拿到列指针，无需解析文本。
+//
+// 文件头（64 字节）：magic "ESTLM01\0"、版本、列数、块容量、时间步长
+// 数据块：块头（magic、行数、首末时间）后依次为
+//   Time(f64) N1L N1R EGTL EGTR FuelLevel FuelFlow(f32) Anomaly(u16) Phase(u8) Valid(u8)
+// 各列按行数紧密排列，块尾补齐到 8 字节；最后一个块可以不满
+//
+// 稀疏时间索引（.tlx，与 .tlm 同名）：每个块一项（偏移、行数、首末时间），
+// 读取端加载后无需逐块访问映射内存即可定位任意时刻；文件追加了新块时只补读新增部分
+
+// 数值列（f32）
+enum class TelemetryChannel {
+    N1Left,
+    N1Right,
+    EGTLeft,
+    EGTRight,
+    FuelLevel,
+    FuelFlow,
+    Count
+};
+
+// 有效位（对应文本日志中的 N/A）
+enum TelemetryValidBit : uint8_t {
+    VALID_N1_LEFT = 1 << 0,
+    VALID_N1_RIGHT = 1 << 1,
+    VALID_EGT_LEFT = 1 << 2,
+    VALID_EGT_RIGHT = 1 << 3,
+    VALID_FUEL_LEVEL = 1 << 4,
+    VALID_FUEL_FLOW = 1 << 5
+};
+
+// 异常状态与 16 位掩码互相转换（9 个传感器故障位 + 超转/超温等级 + 燃油告警）
+uint16_t packAnomaly(const AnomalyState& anomaly);
+AnomalyState unpackAnomaly(uint16_t bits);
+
+// 根据传感器故障状态计算有效位
+uint8_t validMask(const AnomalyState& anomaly);
+
+// 单行记录（读取端逐行访问时使用）
+struct TelemetryRow {
+    double time;
+    float values[static_cast<int>(TelemetryChannel::Count)];
+    uint16_t anomaly;
+    EnginePhase phase;
+    uint8_t valid;
+};
+
+// 一个数据块的零拷贝视图（指针指向映射内存）
+struct TelemetryBlock {
+    size_t firstRow;         // 块内首行在全文件中的行号
+    uint32_t rows;           // 行数
+    double firstTime;        // 首行时间
+    double lastTime;         // 末行时间
+    const double* time;
+    const float* values[static_cast<int>(TelemetryChannel::Count)];
+    const uint16_t* anomaly;
+    const uint8_t* phase;
+    const uint8_t* valid;
+};
+
+// 写入端：按块缓存在内存中，块满或 flush() 时整块写出
+class TelemetryWriter {
+public:
+    // 默认块容量（20 秒数据）
+    static constexpr uint32_t DEFAULT_BLOCK_ROWS = 4096;
+
+    explicit TelemetryWriter(uint32_t blockRows = DEFAULT_BLOCK_ROWS);
+    ~TelemetryWriter();
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    // 创建文件并写入文件头
+    bool open(const std::string& path);
+
+    // 追加一行（data 为 processData 之后的显示数据）
+    void append(double time, const SensorData& data, const AnomalyState& anomaly);
+
+    // 将未满的当前块写出（块头记录实际行数）
+    void flush();
+
+    // 写出剩余数据并关闭
+    void close();
+
+    bool isOpen() const;
+
+    // 已写入行数
+    uint64_t rowCount() const;
+
+private:
+    void writeBlock();
+
+    std::FILE* file;
+    uint32_t blockRows;
+    uint64_t totalRows;
+
+    // 当前块的列缓存
+    std::vector<double> timeColumn;
+    std::vector<float> valueColumns[static_cast<int>(TelemetryChannel::Count)];
+    std::vector<uint16_t> anomalyColumn;
+    std::vector<uint8_t> phaseColumn;
+    std::vector<uint8_t> validColumn;
+
+    // 块序列化缓冲区（复用，避免逐块分配）
+    std::vector<char> blockBuffer;
+};
+
+// 与 .tlm 同名、扩展名不同的附属文件路径（extension 含点号）
+std::string telemetrySiblingPath(const std::string& path, const char* extension);
+
+// 与 .tlm 同名的稀疏时间索引路径
+std::string telemetryIndexPath(const std::string& path);
+
+// 只读内存映射文件
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 映射整个文件（空文件视为失败）
+    bool open(const std::string& path);
+    void close();
+
+    const char* data() const;
+    size_t size() const;
+
+private:
+    const char* mapped;
+    size_t mappedSize;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+// 读取端：内存映射整个文件，打开时只遍历块头建立块索引
+class TelemetryReader {
+public:
+    TelemetryReader();
+    ~TelemetryReader();
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    // 打开并映射文件；文件尾部不完整的块会被忽略。
+    // useIndex 为 true 时先加载 .tlx 索引，只遍历索引之后的块头，索引缺失或有新块时写回
+    bool open(const std::string& path, bool useIndex = false);
+    void close();
+    bool isOpen() const;
+
+    // 总行数与块数
+    size_t rowCount() const;
+    size_t blockCount() const;
+    const TelemetryBlock& block(size_t index) const;
+
+    // 记录时的时间步长
+    double timeStep() const;
+
+    // 读取任意一行
+    bool readRow(size_t row, TelemetryRow& out) const;
+
+    // 查找时间不小于 time 的第一行（按时间分桶直接定位块后在块内二分）
+    size_t findRow(double time) const;
+
+    // 本次打开是否加载了有效的 .tlx 索引
+    bool indexLoaded() const;
+
+private:
+    // 从 offset 起遍历块头追加块，返回遍历结束的位置
+    size_t scanBlocks(size_t offset);
+    void addBlock(size_t offset, uint32_t rows, double firstTime, double lastTime);
+    bool loadIndex(const std::string& indexPath);
+    bool saveIndex(const std::string& indexPath) const;
+    void buildTimeBuckets();
+
+    MappedFile file;
+    const char* mapped;
+    size_t mappedSize;
+    double step;
+    std::vector<TelemetryBlock> blocks;
+    std::vector<size_t> blockOffsets;   // 各块在文件中的偏移（写索引用）
+    size_t totalRows;
+    bool loadedIndex;
+
+    // 时间分桶：bucketStart[k] 为末行时间不小于 firstTime + k * bucketWidth 的第一个块
+    std::vector<uint32_t> bucketStart;
+    double bucketWidth;
+};
+
+#endif // TELEMETRYLOG_H
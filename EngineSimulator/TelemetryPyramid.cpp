@@ -0,0 +1,341 @@
+#include "TelemetryPyramid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+constexpr int CHANNEL_COUNT = static_cast<int>(TelemetryChannel::Count);
+constexpr uint32_t PYRAMID_VERSION = 1;
+constexpr char PYRAMID_MAGIC[8] = { 'E', 'S', 'T', 'L', 'P', '0', '1', '\0' };
+
+// 各列对应的有效位（与 CSV 的 N/A 一致），燃油两列始终计入
+constexpr uint8_t CHANNEL_VALID_BITS[CHANNEL_COUNT] = {
+    VALID_N1_LEFT, VALID_N1_RIGHT, VALID_EGT_LEFT, VALID_EGT_RIGHT, 0, 0
+};
+
+bool channelValid(uint8_t valid, int channel) {
+    return CHANNEL_VALID_BITS[channel] == 0 || (valid & CHANNEL_VALID_BITS[channel]) != 0;
+}
+
+// 文件头（按小端序直接写出）
+struct PyramidHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t channelCount;
+    uint32_t firstShift;
+    uint32_t levelCount;
+    uint64_t sourceRows;
+    double timeStep;
+    char padding[24];
+};
+static_assert(sizeof(PyramidHeader) == 64, "PyramidHeader layout");
+
+// 级表项
+struct PyramidLevel {
+    uint32_t shift;
+    uint32_t reserved;
+    uint64_t buckets;
+    uint64_t offset;   // 该级数据在文件中的偏移
+};
+static_assert(sizeof(PyramidLevel) == 24, "PyramidLevel layout");
+
+// 一级数据的字节数（补齐到 8 字节）
+uint64_t levelBytes(uint64_t buckets) {
+    const uint64_t bytes = buckets * sizeof(double) + buckets * 3 * sizeof(float) * CHANNEL_COUNT;
+    return (bytes + 7) & ~uint64_t(7);
+}
+
+// 建立过程中的一级：各列的最小值、最大值、有效行数和有效行之和
+struct LevelBuilder {
+    std::vector<double> time;
+    std::vector<float> min[CHANNEL_COUNT];
+    std::vector<float> max[CHANNEL_COUNT];
+    std::vector<uint32_t> count[CHANNEL_COUNT];
+    std::vector<double> sum[CHANNEL_COUNT];
+
+    void resize(size_t buckets) {
+        time.assign(buckets, 0.0);
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            min[c].assign(buckets, std::numeric_limits<float>::infinity());
+            max[c].assign(buckets, -std::numeric_limits<float>::infinity());
+            count[c].assign(buckets, 0);
+            sum[c].assign(buckets, 0.0);
+        }
+    }
+
+    // 写出一级：无有效行的桶记为 NaN
+    bool write(std::FILE* file) const {
+        const size_t buckets = time.size();
+        bool ok = std::fwrite(time.data(), sizeof(double), buckets, file) == buckets;
+        std::vector<float> stats(buckets * 3);
+        for (int c = 0; c < CHANNEL_COUNT && ok; ++c) {
+            for (size_t i = 0; i < buckets; ++i) {
+                const bool empty = count[c][i] == 0;
+                stats[i * 3] = empty ? NAN : min[c][i];
+                stats[i * 3 + 1] = empty ? NAN : max[c][i];
+                stats[i * 3 + 2] = empty ? NAN : static_cast<float>(sum[c][i] / count[c][i]);
+            }
+            ok = std::fwrite(stats.data(), sizeof(float), stats.size(), file) == stats.size();
+        }
+        const uint64_t written = buckets * sizeof(double) + stats.size() * sizeof(float) * CHANNEL_COUNT;
+        const char zeros[8] = {};
+        const size_t pad = static_cast<size_t>(levelBytes(buckets) - written);
+        return ok && std::fwrite(zeros, 1, pad, file) == pad;
+    }
+};
+
+} // namespace
+
+std::string telemetryPyramidPath(const std::string& path) {
+    return telemetrySiblingPath(path, ".tlp");
+}
+
+// 建立金字塔：最细一级逐行汇总，之后每一级由上一级两两合并，内存中只同时保留相邻两级
+bool buildTelemetryPyramid(const TelemetryReader& reader, const std::string& path) {
+    const uint64_t rows = reader.rowCount();
+    if (rows == 0) return false;
+
+    // 级表：桶数每级减半，直到只剩一个桶
+    std::vector<PyramidLevel> table;
+    uint64_t offset = sizeof(PyramidHeader);
+    for (uint32_t shift = TelemetryPyramid::FIRST_SHIFT;; ++shift) {
+        const uint64_t buckets = ((rows - 1) >> shift) + 1;
+        table.push_back({ shift, 0, buckets, 0 });
+        if (buckets == 1) break;
+    }
+    offset += table.size() * sizeof(PyramidLevel);
+    for (PyramidLevel& level : table) {
+        level.offset = offset;
+        offset += levelBytes(level.buckets);
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open pyramid file: " << path << "\n";
+        return false;
+    }
+    PyramidHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PYRAMID_MAGIC, sizeof(header.magic));
+    header.version = PYRAMID_VERSION;
+    header.channelCount = CHANNEL_COUNT;
+    header.firstShift = TelemetryPyramid::FIRST_SHIFT;
+    header.levelCount = static_cast<uint32_t>(table.size());
+    header.sourceRows = rows;
+    header.timeStep = reader.timeStep();
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(table.data(), sizeof(PyramidLevel), table.size(), file) == table.size();
+
+    // 最细一级：按块顺序逐列扫描
+    LevelBuilder current;
+    current.resize(static_cast<size_t>(table[0].buckets));
+    for (size_t b = 0; b < reader.blockCount(); ++b) {
+        const TelemetryBlock& block = reader.block(b);
+        for (uint32_t i = 0; i < block.rows; ++i) {
+            const size_t row = block.firstRow + i;
+            const size_t bucket = row >> TelemetryPyramid::FIRST_SHIFT;
+            if ((row & ((size_t(1) << TelemetryPyramid::FIRST_SHIFT) - 1)) == 0) {
+                current.time[bucket] = block.time[i];
+            }
+        }
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            const float* values = block.values[c];
+            for (uint32_t i = 0; i < block.rows; ++i) {
+                if (!channelValid(block.valid[i], c)) continue;
+                const size_t bucket = (block.firstRow + i) >> TelemetryPyramid::FIRST_SHIFT;
+                current.min[c][bucket] = std::min(current.min[c][bucket], values[i]);
+                current.max[c][bucket] = std::max(current.max[c][bucket], values[i]);
+                current.sum[c][bucket] += values[i];
+                ++current.count[c][bucket];
+            }
+        }
+    }
+
+    // 写出当前一级后两两合并出下一级
+    for (size_t level = 0; ok && level < table.size(); ++level) {
+        ok = current.write(file);
+        if (!ok || level + 1 == table.size()) break;
+        LevelBuilder next;
+        next.resize(static_cast<size_t>(table[level + 1].buckets));
+        for (size_t i = 0; i < next.time.size(); ++i) {
+            const size_t a = i * 2;
+            const size_t b = std::min(a + 1, current.time.size() - 1);
+            next.time[i] = current.time[a];
+            for (int c = 0; c < CHANNEL_COUNT; ++c) {
+                next.min[c][i] = std::min(current.min[c][a], current.min[c][b]);
+                next.max[c][i] = std::max(current.max[c][a], current.max[c][b]);
+                next.count[c][i] = current.count[c][a] + (b != a ? current.count[c][b] : 0);
+                next.sum[c][i] = current.sum[c][a] + (b != a ? current.sum[c][b] : 0.0);
+            }
+        }
+        current = std::move(next);
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) std::cerr << "Failed to write pyramid file: " << path << "\n";
+    return ok;
+}
+
+// ---------------- 读取端 ----------------
+
+// 打开并校验文件头和级表（各级须首尾相接且不超出文件）
+bool TelemetryPyramid::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+    const char* mapped = file.data();
+    PyramidHeader header;
+    bool ok = file.size() >= sizeof(header);
+    if (ok) {
+        std::memcpy(&header, mapped, sizeof(header));
+        ok = std::memcmp(header.magic, PYRAMID_MAGIC, sizeof(header.magic)) == 0
+            && header.version == PYRAMID_VERSION && header.channelCount == CHANNEL_COUNT
+            && header.levelCount > 0 && header.levelCount < 64
+            && file.size() >= sizeof(header) + header.levelCount * sizeof(PyramidLevel);
+    }
+    uint64_t expected = sizeof(PyramidHeader) + (ok ? header.levelCount * sizeof(PyramidLevel) : 0);
+    for (uint32_t l = 0; ok && l < header.levelCount; ++l) {
+        PyramidLevel entry;
+        std::memcpy(&entry, mapped + sizeof(header) + l * sizeof(PyramidLevel), sizeof(entry));
+        ok = entry.offset == expected && entry.buckets > 0 && expected + levelBytes(entry.buckets) <= file.size();
+        if (!ok) break;
+        Level level;
+        level.shift = entry.shift;
+        level.buckets = static_cast<size_t>(entry.buckets);
+        level.time = reinterpret_cast<const double*>(mapped + entry.offset);
+        const char* stats = mapped + entry.offset + entry.buckets * sizeof(double);
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            level.stats[c] = reinterpret_cast<const float*>(stats + c * entry.buckets * 3 * sizeof(float));
+        }
+        levels.push_back(level);
+        expected += levelBytes(entry.buckets);
+    }
+    if (!ok) {
+        std::cerr << "Not a telemetry pyramid file: " << path << "\n";
+        close();
+        return false;
+    }
+    rows = header.sourceRows;
+    return true;
+}
+
+void TelemetryPyramid::close() {
+    file.close();
+    levels.clear();
+    rows = 0;
+}
+
+bool TelemetryPyramid::isOpen() const {
+    return !levels.empty();
+}
+
+uint64_t TelemetryPyramid::sourceRows() const {
+    return rows;
+}
+
+size_t TelemetryPyramid::levelCount() const {
+    return levels.size();
+}
+
+uint32_t TelemetryPyramid::levelShift(size_t level) const {
+    return levels[level].shift;
+}
+
+size_t TelemetryPyramid::bucketCount(size_t level) const {
+    return levels[level].buckets;
+}
+
+// 按范围内的行数选级：最粗一级的桶数仍不少于 2 * pixels
+uint32_t TelemetryPyramid::query(TelemetryChannel channel, double from, double to, size_t pixels,
+    std::vector<TrendPoint>& out, const TelemetryReader* raw) const {
+    out.clear();
+    if (levels.empty() || !(to >= from)) return 0;
+    const int c = static_cast<int>(channel);
+    const Level& finest = levels.front();
+
+    // 范围内的桶区间（from 所在桶到 to 所在桶）
+    auto bucketRange = [from, to](const Level& level) {
+        const double* begin = level.time;
+        const double* end = level.time + level.buckets;
+        const double* first = std::upper_bound(begin, end, from);
+        const double* last = std::upper_bound(begin, end, to);
+        return std::make_pair(static_cast<size_t>(first == begin ? 0 : first - begin - 1),
+            static_cast<size_t>(last == begin ? 0 : last - begin - 1));
+    };
+
+    const auto span = bucketRange(finest);
+    const uint64_t rangeRows = static_cast<uint64_t>(span.second - span.first + 1) << finest.shift;
+    const uint64_t target = std::max<uint64_t>(2 * static_cast<uint64_t>(pixels), 1);
+
+    // 比最细一级更细：原始行现场按 2^shift 行一桶汇总（最多读取 2^FIRST_SHIFT * target 行）
+    if (raw && raw->rowCount() > 0 && (rangeRows >> finest.shift) < target) {
+        auto rowAtOrBefore = [raw](double time) {
+            size_t row = std::min(raw->findRow(time), raw->rowCount() - 1);
+            TelemetryRow record;
+            if (row > 0 && raw->readRow(row, record) && record.time > time) --row;
+            return row;
+        };
+        size_t lastRow = rowAtOrBefore(to);
+        size_t row = rowAtOrBefore(from);
+        uint32_t shift = 0;
+        while (shift + 1 < finest.shift && ((lastRow - row + 1) >> (shift + 1)) >= target) ++shift;
+        // 与金字塔各级一致：首末两桶都取整桶
+        row = row >> shift << shift;
+        lastRow = std::min((((lastRow >> shift) + 1) << shift) - 1, raw->rowCount() - 1);
+
+        // 从所在块起按块顺序读取
+        size_t lo = 0, hi = raw->blockCount();
+        while (hi - lo > 1) {
+            const size_t mid = (lo + hi) / 2;
+            (raw->block(mid).firstRow <= row ? lo : hi) = mid;
+        }
+        TrendPoint point{ 0.0, 0.0f, 0.0f, 0.0f };
+        double sum = 0.0;
+        uint32_t count = 0;
+        size_t bucket = SIZE_MAX;
+        auto emit = [&]() {
+            if (bucket == SIZE_MAX) return;
+            if (count == 0) point.min = point.max = point.mean = NAN;
+            else point.mean = static_cast<float>(sum / count);
+            out.push_back(point);
+        };
+        for (size_t b = lo; b < raw->blockCount() && row <= lastRow; ++b) {
+            const TelemetryBlock& block = raw->block(b);
+            for (size_t i = row - block.firstRow; i < block.rows && row <= lastRow; ++i, ++row) {
+                if ((row >> shift) != bucket) {
+                    emit();
+                    bucket = row >> shift;
+                    point = { block.time[i], std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.0f };
+                    sum = 0.0;
+                    count = 0;
+                }
+                if (!channelValid(block.valid[i], c)) continue;
+                const float value = block.values[c][i];
+                point.min = std::min(point.min, value);
+                point.max = std::max(point.max, value);
+                sum += value;
+                ++count;
+            }
+        }
+        emit();
+        return shift;
+    }
+
+    size_t chosen = 0;
+    for (size_t l = 1; l < levels.size(); ++l) {
+        if ((rangeRows >> levels[l].shift) < target) break;
+        chosen = l;
+    }
+    const Level& level = levels[chosen];
+    const auto range = bucketRange(level);
+    out.reserve(range.second - range.first + 1);
+    for (size_t i = range.first; i <= range.second; ++i) {
+        const float* stats = level.stats[c] + i * 3;
+        out.push_back({ level.time[i], stats[0], stats[1], stats[2] });
+    }
+    return level.shift;
+}
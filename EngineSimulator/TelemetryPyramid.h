@@ -0,0 +1,73 @@
+#ifndef TELEMETRYPYRAMID_H
+#define TELEMETRYPYRAMID_H
+
+#include "TelemetryLog.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 多分辨率趋势金字塔（.tlp，与 .tlm 同名）
+// 每个数值列按 2 的幂抽取分级：第 k 级每个桶汇总 2^(FIRST_SHIFT + k) 行的最小值、最大值和平均值
+// （只统计有效行，桶内全部无效时三者为 NaN），每级记录各桶首行时间。
+// 绘制任意时间范围时取桶数不少于 2 倍像素宽度的最粗一级，读取的点数约为像素宽度的 2~4 倍，
+// 与范围内的原始行数无关；范围短到最细一级也不够时，原始行现场按更细的 2 的幂次汇总。
+//
+// 文件 = 文件头（64 字节）+ 级表（每级 24 字节）+ 各级数据；
+// 每级依次为 Time(f64 x 桶数)、各列 {min, max, mean}(f32 x 3 x 桶数)，级尾补齐到 8 字节
+
+// 一个趋势点（原始行的最小值、最大值和平均值相同）
+struct TrendPoint {
+    double time;   // 桶首行时间
+    float min;
+    float max;
+    float mean;
+};
+
+// 从数据日志建立金字塔并写出（覆盖原文件）
+bool buildTelemetryPyramid(const TelemetryReader& reader, const std::string& path);
+
+// 与 .tlm 同名的金字塔路径
+std::string telemetryPyramidPath(const std::string& path);
+
+// 读取端：内存映射，打开时只读文件头和级表
+class TelemetryPyramid {
+public:
+    // 最细一级每桶 2^FIRST_SHIFT 行（金字塔总大小约为原始数据的 30%）
+    static constexpr uint32_t FIRST_SHIFT = 4;
+
+    TelemetryPyramid() = default;
+    TelemetryPyramid(const TelemetryPyramid&) = delete;
+    TelemetryPyramid& operator=(const TelemetryPyramid&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // 建立时数据日志的总行数（与当前 .tlm 不同说明日志已追加，需要重建）
+    uint64_t sourceRows() const;
+
+    size_t levelCount() const;
+    // 第 level 级每桶的行数（2 的幂次）与桶数
+    uint32_t levelShift(size_t level) const;
+    size_t bucketCount(size_t level) const;
+
+    // 读取 [from, to] 内 channel 的趋势点（含 from、to 所在的桶），返回所用级别每桶行数的 2 的幂次；
+    // 需要比最细一级更细时从 raw 的原始行现场汇总（raw 为空时仍用最细一级）
+    uint32_t query(TelemetryChannel channel, double from, double to, size_t pixels,
+        std::vector<TrendPoint>& out, const TelemetryReader* raw = nullptr) const;
+
+private:
+    struct Level {
+        uint32_t shift;
+        size_t buckets;
+        const double* time;
+        const float* stats[static_cast<int>(TelemetryChannel::Count)];   // 每桶 {min, max, mean}
+    };
+
+    MappedFile file;
+    uint64_t rows = 0;
+    std::vector<Level> levels;
+};
+
+#endif // TELEMETRYPYRAMID_H
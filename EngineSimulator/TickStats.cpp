@@ -0,0 +1,156 @@
+#include "TickStats.h"
+#include "EngineState.h"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+// 最高有效位的位置（value > 0）
+static int highestBit(uint64_t value) {
+    int bit = 0;
+    for (int step = 32; step > 0; step >>= 1) {
+        if (value >> (bit + step)) bit += step;
+    }
+    return bit;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : total(0), sum(0), minimum(std::numeric_limits<uint64_t>::max()), maximum(0) {
+    for (std::atomic<uint64_t>& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+// 小于 SUB_BUCKETS 的值各占一个桶；更大的值取最高 SUB_BUCKET_BITS 位，同一级内按这几位线性分桶
+size_t LatencyHistogram::bucketIndex(uint64_t ns) {
+    ns = std::min(ns, (uint64_t(1) << MAX_VALUE_BITS) - 1);
+    if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+    const int shift = highestBit(ns) - (SUB_BUCKET_BITS - 1);
+    const uint64_t top = ns >> shift;
+    return static_cast<size_t>(SUB_BUCKETS + (shift - 1) * (SUB_BUCKETS / 2) + (top - SUB_BUCKETS / 2));
+}
+
+uint64_t LatencyHistogram::bucketLow(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    const size_t offset = index - SUB_BUCKETS;
+    const int shift = static_cast<int>(offset / (SUB_BUCKETS / 2)) + 1;
+    const uint64_t top = SUB_BUCKETS / 2 + offset % (SUB_BUCKETS / 2);
+    return top << shift;
+}
+
+uint64_t LatencyHistogram::bucketHigh(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    const int shift = static_cast<int>((index - SUB_BUCKETS) / (SUB_BUCKETS / 2)) + 1;
+    return bucketLow(index) + (uint64_t(1) << shift) - 1;
+}
+
+// 单写者：读改写不需要原子指令，读取方看到的每个计数都是完整的值
+void LatencyHistogram::record(uint64_t ns) {
+    std::atomic<uint64_t>& bucket = buckets[bucketIndex(ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum.store(sum.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns < minimum.load(std::memory_order_relaxed)) minimum.store(ns, std::memory_order_relaxed);
+    if (ns > maximum.load(std::memory_order_relaxed)) maximum.store(ns, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::count() const {
+    return total.load(std::memory_order_acquire);
+}
+
+uint64_t LatencyHistogram::bucketCount(size_t index) const {
+    return buckets[index].load(std::memory_order_relaxed);
+}
+
+// 摘要：先复制各桶计数，总数以复制结果为准（与写入线程并发时各项可能相差一两次记录）
+HistogramSummary LatencyHistogram::summary() const {
+    HistogramSummary result;
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t counted = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        counted += counts[i];
+    }
+    if (counted == 0) return result;
+
+    result.count = counted;
+    result.min = minimum.load(std::memory_order_relaxed);
+    result.max = maximum.load(std::memory_order_relaxed);
+    result.mean = static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(counted);
+
+    const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    uint64_t* outputs[] = { &result.p50, &result.p90, &result.p99, &result.p999 };
+    size_t index = 0;
+    uint64_t cumulative = 0;
+    for (int q = 0; q < 4; ++q) {
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantiles[q] * static_cast<double>(counted) + 0.5));
+        while (cumulative + counts[index] < rank) {
+            cumulative += counts[index];
+            ++index;
+        }
+        *outputs[q] = std::min(bucketHigh(index), result.max);
+    }
+    return result;
+}
+
+const char* tickStageName(TickStage stage) {
+    switch (stage) {
+    case TickStage::Generate: return "generate";
+    case TickStage::Check: return "check";
+    case TickStage::Publish: return "publish";
+    case TickStage::Display: return "display";
+    case TickStage::Log: return "log";
+    case TickStage::Count: break;
+    }
+    return "unknown";
+}
+
+// 统计表的一行（微秒）
+static void appendRow(std::string& text, const char* name, const LatencyHistogram& histogram) {
+    const HistogramSummary s = histogram.summary();
+    char line[192];
+    std::snprintf(line, sizeof(line), "%-15s %10llu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+        name, static_cast<unsigned long long>(s.count), s.min * 1e-3, s.p50 * 1e-3, s.p90 * 1e-3,
+        s.p99 * 1e-3, s.p999 * 1e-3, s.max * 1e-3, s.mean * 1e-3);
+    text += line;
+}
+
+std::string formatTickStats(const TickStats& stats) {
+    std::string text;
+    char line[192];
+    std::snprintf(line, sizeof(line), "%-15s %10s %9s %9s %9s %9s %9s %9s %9s\n",
+        "us", "count", "min", "p50", "p90", "p99", "p99.9", "max", "mean");
+    text += line;
+    appendRow(text, "timer lateness", stats.timerLateness);
+    for (size_t i = 0; i < static_cast<size_t>(TickStage::Count); ++i) {
+        appendRow(text, tickStageName(static_cast<TickStage>(i)), stats.stages[i]);
+    }
+    std::snprintf(line, sizeof(line), "overruns (> %.0f ms): %llu of %llu steps\n", TIME_STEP * 1e3,
+        static_cast<unsigned long long>(stats.overruns.load(std::memory_order_relaxed)),
+        static_cast<unsigned long long>(stats.stage(TickStage::Generate).count()));
+    text += line;
+    return text;
+}
+
+// 文件：统计表，之后每个非空桶一行 "<直方图>,<下界 ns>,<上界 ns>,<计数>"
+bool writeTickStats(const std::string& path, const TickStats& stats) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fputs("# EngineSimulator tick timing, cumulative\n", file);
+    std::fputs(formatTickStats(stats).c_str(), file);
+    std::fputs("# histogram,low_ns,high_ns,count\n", file);
+    auto writeBuckets = [file](const char* name, const LatencyHistogram& histogram) {
+        for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+            const uint64_t count = histogram.bucketCount(i);
+            if (count == 0) continue;
+            std::fprintf(file, "%s,%llu,%llu,%llu\n", name,
+                static_cast<unsigned long long>(LatencyHistogram::bucketLow(i)),
+                static_cast<unsigned long long>(LatencyHistogram::bucketHigh(i)),
+                static_cast<unsigned long long>(count));
+        }
+    };
+    writeBuckets("timer lateness", stats.timerLateness);
+    for (size_t i = 0; i < static_cast<size_t>(TickStage::Count); ++i) {
+        writeBuckets(tickStageName(static_cast<TickStage>(i)), stats.stages[i]);
+    }
+    return std::fclose(file) == 0;
+}
@@ -0,0 +1,121 @@
+#ifndef TICKSTATS_H
+#define TICKSTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 实时性统计
+// 模拟线程的唤醒延迟和每一步各阶段的耗时记录为 HDR 风格直方图，始终开启：
+// 数值按 2 的幂分级，每级再等分为 64 个线性子桶，相对误差不超过 1/64，覆盖 0 ~ 约 68 秒（纳秒）。
+// 每个直方图只由一个线程写入（一次记录只是几次 relaxed 原子读写，不加锁），任何线程可随时读取统计
+
+// 直方图统计摘要（纳秒）
+struct HistogramSummary {
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+};
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+    static constexpr int MAX_VALUE_BITS = 36;   // 超过 2^36 ns 的值计入最后一个桶
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * (SUB_BUCKETS / 2);
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // 记录一个值（仅限写入线程）
+    void record(uint64_t ns);
+
+    // 统计摘要；百分位取所在桶的上界（偏保守）
+    HistogramSummary summary() const;
+
+    uint64_t count() const;
+    uint64_t bucketCount(size_t index) const;
+
+    // 桶编号与取值范围 [bucketLow, bucketHigh]
+    static size_t bucketIndex(uint64_t ns);
+    static uint64_t bucketLow(size_t index);
+    static uint64_t bucketHigh(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> minimum;
+    std::atomic<uint64_t> maximum;
+};
+
+// 每一步的阶段
+enum class TickStage {
+    Generate,   // 数据生成（DataGenerator::updateData）
+    Check,      // 阈值规则求值
+    Publish,    // 写入各消费者缓冲区
+    Display,    // 界面刷新（读取最新样本、更新仪表和按钮，不含之后的绘制）
+    Log,        // 日志记录（Logger::consume，在日志线程中）
+    Count
+};
+
+const char* tickStageName(TickStage stage);
+
+// 一次会话的实时性统计（自创建起累计）
+struct TickStats {
+    // 模拟线程唤醒时刻相对最早到期一步的延迟
+    LatencyHistogram timerLateness;
+    LatencyHistogram stages[static_cast<size_t>(TickStage::Count)];
+    // 完成时刻晚于到期时刻超过一个 TIME_STEP 的步数（含追赶上限丢弃的步）
+    std::atomic<uint64_t> overruns{ 0 };
+
+    LatencyHistogram& stage(TickStage which) {
+        return stages[static_cast<size_t>(which)];
+    }
+    const LatencyHistogram& stage(TickStage which) const {
+        return stages[static_cast<size_t>(which)];
+    }
+    void addOverruns(uint64_t count) {
+        overruns.fetch_add(count, std::memory_order_relaxed);
+    }
+};
+
+// 单调时钟（纳秒）
+inline uint64_t statsClockNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 分段计时：每次 lap() 记录自上一次 lap（或构造）以来的耗时；stats 为空时不读时钟
+class StageTimer {
+public:
+    explicit StageTimer(TickStats* stats) : stats(stats), last(stats ? statsClockNs() : 0) {
+    }
+    void lap(TickStage stage) {
+        if (!stats) return;
+        const uint64_t now = statsClockNs();
+        stats->stage(stage).record(now - last);
+        last = now;
+    }
+
+private:
+    TickStats* stats;
+    uint64_t last;
+};
+
+// 统计表（微秒），界面面板和文件共用
+std::string formatTickStats(const TickStats& stats);
+
+// 写出统计表和全部非空桶（覆盖原文件）
+bool writeTickStats(const std::string& path, const TickStats& stats);
+
+#endif // TICKSTATS_H
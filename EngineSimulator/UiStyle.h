@@ -0,0 +1,114 @@
+#pragma once
+#ifndef UISTYLE_H
+#define UISTYLE_H
+#include <QString>
+#include <QStyle>
+#include <QVariant>
+#include <QWidget>
+
+// 界面样式
+// 全部样式集中在一张样式表中，由主窗口在启动时设置一次（只解析一次）。
+// 控件的报警状态用动态属性表示，切换状态只修改属性并重新 polish，不再重新解析样式表：
+//   异常按钮：alertLevel = normal / white / amber / red
+//   启动、运行指示灯：lit = true / false
+//   燃油流速显示：overSpeed = true / false
+const QString APP_STYLE_SHEET = R"(
+    /* 普通状态（非报警）- 灰色基底 */
+    QPushButton[alertLevel="normal"] {
+        background-color: #333333;
+        color: white;
+        border: 1px solid #666666;
+        border-radius: 5px;
+    }
+    QPushButton[alertLevel="normal"]:hover {
+        background-color: #444444;
+    }
+    QPushButton[alertLevel="normal"]:pressed {
+        background-color: #555555;
+        border: 2px solid #FF9800;
+    }
+
+    /* 报警状态1 - 白色（高对比度白，适配深色基底） */
+    QPushButton[alertLevel="white"] {
+        background-color: #FFFFFF;
+        color: #222222;
+        border: 2px solid #EEEEEE;
+        border-radius: 5px;
+        font-weight: bold;
+    }
+    QPushButton[alertLevel="white"]:hover {
+        background-color: #F5F5F5;
+    }
+
+    /* 报警状态2 - 琥珀色/黄色（预警级别） */
+    QPushButton[alertLevel="amber"] {
+        background-color: #FFC107;
+        color: #222222;
+        border: 2px solid #FFA000;
+        border-radius: 5px;
+        font-weight: bold;
+    }
+    QPushButton[alertLevel="amber"]:hover {
+        background-color: #FFD54F;
+    }
+
+    /* 报警状态3 - 红色（紧急级别） */
+    QPushButton[alertLevel="red"] {
+        background-color: #F44336;
+        color: white;
+        border: 2px solid #FF5252;
+        border-radius: 5px;
+        font-weight: bold;
+    }
+    QPushButton[alertLevel="red"]:hover {
+        background-color: #EF5350;
+    }
+
+    /* 启动、运行指示灯 */
+    QLabel[lit="false"] {
+        background-color: gray;
+        color: white;
+        font-weight: bold;
+    }
+    QLabel[lit="true"] {
+        background-color: green;
+        color: white;
+        font-weight: bold;
+    }
+
+    /* 燃油流速显示：超速时为琥珀色 */
+    QLabel#lcdFuelFlow {
+        color: white;
+        font-family: "Courier New", monospace;
+        font-size: 24pt;
+        font-weight: bold;
+        background-color: black;
+        border: 1px solid #444;
+        padding: 5px;
+    }
+    QLabel#lcdFuelFlow[overSpeed="true"] {
+        color: #FFBF00;
+    }
+)";
+
+// 异常按钮的报警状态
+const char* const BTN_STATE_NORMAL = "normal";
+const char* const BTN_STATE_WHITE = "white";
+const char* const BTN_STATE_AMBER = "amber";
+const char* const BTN_STATE_RED = "red";
+
+// 切换控件的样式状态：属性未变化时直接返回，变化时只重新 polish 该控件
+inline void setStyleState(QWidget* widget, const char* name, const char* value) {
+    const QString state = QString::fromLatin1(value);
+    if (widget->property(name).toString() == state) return;
+    widget->setProperty(name, state);
+    widget->style()->unpolish(widget);
+    widget->style()->polish(widget);
+}
+
+// 异常按钮
+inline void setButtonState(QWidget* button, const char* state) {
+    setStyleState(button, "alertLevel", state);
+}
+
+#endif // UISTYLE_H
@@ -0,0 +1,126 @@
+#include "WorkStealingPool.h"
+
+namespace {
+
+// 当前线程所属的线程池及其队列编号（非工作线程为 nullptr）
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+} // namespace
+
+// 构造：创建队列并启动工作线程
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : queued(0), pending(0), nextQueue(0), stolen(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+// 析构：执行完剩余任务后退出
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// 提交任务
+void WorkStealingPool::submit(Task task) {
+    size_t index;
+    if (currentPool == this) {
+        index = currentIndex;
+    }
+    else {
+        index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    queued.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+// 等待已提交的任务全部完成
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+size_t WorkStealingPool::threadCount() const {
+    return workers.size();
+}
+
+uint64_t WorkStealingPool::stolenCount() const {
+    return stolen.load(std::memory_order_relaxed);
+}
+
+// 从自己的队列队尾取任务（最近提交的任务数据还在缓存中）
+bool WorkStealingPool::popLocal(size_t index, Task& task) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+// 从其他队列队首窃取任务，从相邻队列开始依次尝试
+bool WorkStealingPool::steal(size_t index, Task& task) {
+    const size_t count = queues.size();
+    for (size_t offset = 1; offset < count; ++offset) {
+        Queue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        stolen.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// 工作线程主循环
+void WorkStealingPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    for (;;) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                doneCondition.notify_all();
+            }
+            continue;
+        }
+
+        // 没有可执行的任务：休眠到有新任务或线程池停止
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this] {
+            return stopping || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
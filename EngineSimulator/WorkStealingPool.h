@@ -0,0 +1,70 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池
+// 每个工作线程有自己的任务队列：从队尾取自己的任务，自己的队列空了再从其他队列的队首窃取。
+// 外部提交的任务轮流分配到各队列；任务内部提交的子任务进入当前线程自己的队列
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // threadCount 为 0 时使用硬件线程数
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 提交任务
+    void submit(Task task);
+
+    // 等待已提交的任务全部完成
+    void wait();
+
+    size_t threadCount() const;
+
+    // 被窃取的任务数（调试、统计用）
+    uint64_t stolenCount() const;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // 工作线程主循环
+    void workerLoop(size_t index);
+
+    // 从自己的队列队尾取任务
+    bool popLocal(size_t index, Task& task);
+
+    // 从其他队列队首窃取任务
+    bool steal(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    // 队列中等待执行的任务数、尚未完成的任务数
+    std::atomic<size_t> queued;
+    std::atomic<size_t> pending;
+    std::atomic<size_t> nextQueue;
+    std::atomic<uint64_t> stolen;
+    bool stopping;
+
+    // 空闲线程休眠与 wait() 的唤醒
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -1,11 +1,40 @@
 #include "EngineSimulator.h"
 #include <QtWidgets/QApplication>
+#include <QStringList>
+#include <cstdio>
 
 // 主函数
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
     EngineSimulator window;
+    // --refresh-rate <hz>：界面刷新率，默认 60
+    const QStringList args = app.arguments();
+    const int rateIndex = args.indexOf("--refresh-rate");
+    if (rateIndex >= 0 && rateIndex + 1 < args.size()) {
+        window.setRefreshRate(args.at(rateIndex + 1).toInt());
+    }
+    // --bench-update-sensor <n>：测量异常按钮状态切换的耗时后退出
+    const int benchIndex = args.indexOf("--bench-update-sensor");
+    if (benchIndex >= 0) {
+        const int iterations = benchIndex + 1 < args.size() ? args.at(benchIndex + 1).toInt() : 10000;
+        std::printf("updateSensor: %.2f us per call (%d calls)\n", window.benchmarkUpdateSensor(iterations), iterations);
+        return 0;
+    }
+    // --trace：启动即开始跨度追踪（F11 停止，退出时也会写出）
+    if (args.contains("--trace")) {
+        window.toggleTracing();
+    }
+    // --replay <file.jnl>：以最快速度回放输入日志
+    const int replayIndex = args.indexOf("--replay");
+    if (replayIndex >= 0 && replayIndex + 1 < args.size()) {
+        window.replayJournal(args.at(replayIndex + 1));
+    }
+    // --playback <file.tlm>：打开已记录的会话进入回放
+    const int playbackIndex = args.indexOf("--playback");
+    if (playbackIndex >= 0 && playbackIndex + 1 < args.size()) {
+        window.openPlayback(args.at(playbackIndex + 1));
+    }
     window.show();
     return app.exec();
 }